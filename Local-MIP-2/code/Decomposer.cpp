@@ -0,0 +1,235 @@
+/*=====================================================================================
+
+    Filename:     Decomposer.cpp
+
+    Description:  Connected components of the constraint-variable graph
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "Decomposer.h"
+
+Decomposer::Decomposer(
+    const ModelConUtil *_modelConUtil,
+    const ModelVarUtil *_modelVarUtil)
+    : modelConUtil(_modelConUtil),
+      modelVarUtil(_modelVarUtil),
+      componentNum(0),
+      conComponentNum(0)
+{
+}
+
+Decomposer::~Decomposer()
+{
+  for (auto *conUtil : groupConUtils)
+    delete conUtil;
+  for (auto *varUtil : groupVarUtils)
+    delete varUtil;
+}
+
+// 路径减半
+size_t Decomposer::Find(
+    size_t _varIdx)
+{
+  while (parent[_varIdx] != _varIdx)
+  {
+    parent[_varIdx] = parent[parent[_varIdx]];
+    _varIdx = parent[_varIdx];
+  }
+  return _varIdx;
+}
+
+// 按集合大小合并
+void Decomposer::Union(
+    size_t _varIdx1,
+    size_t _varIdx2)
+{
+  size_t root1 = Find(_varIdx1);
+  size_t root2 = Find(_varIdx2);
+  if (root1 == root2)
+    return;
+  if (setSize[root1] < setSize[root2])
+    swap(root1, root2);
+  parent[root2] = root1;
+  setSize[root1] += setSize[root2];
+}
+
+// 返回组数；固定变量在读入时已代入，不再连接任何约束
+size_t Decomposer::Decompose(
+    size_t _maxGroupNum)
+{
+  size_t varNum = modelVarUtil->varNum;
+  size_t conNum = modelConUtil->conNum;
+  parent.resize(varNum);
+  setSize.assign(varNum, 1);
+  for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+    parent[varIdx] = varIdx;
+  for (size_t conIdx = 1; conIdx < conNum; ++conIdx)
+  {
+    const auto &modelCon = modelConUtil->conSet[conIdx];
+    for (size_t termIdx = 1; termIdx < modelCon.termNum; ++termIdx)
+      Union(modelCon.varIdxSet[0], modelCon.varIdxSet[termIdx]);
+  }
+
+  // 分量规模：变量数加所含约束的项数；只出现在目标函数中的变量自成一个无约束分量
+  const size_t noComponent = std::numeric_limits<size_t>::max();
+  vector<size_t> rootComponent(varNum, noComponent);
+  vector<size_t> componentLoad;
+  vector<bool> isConComponent;
+  for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+  {
+    size_t root = Find(varIdx);
+    if (rootComponent[root] == noComponent)
+    {
+      rootComponent[root] = componentLoad.size();
+      componentLoad.push_back(0);
+      isConComponent.push_back(false);
+    }
+    const auto &modelVar = modelVarUtil->varSet[varIdx];
+    componentLoad[rootComponent[root]] += 1 + modelVar.termNum;
+    if (modelVar.termNum > 0 && modelVar.conIdxSet[modelVar.termNum - 1] > 0)
+      isConComponent[rootComponent[root]] = true;
+  }
+  componentNum = componentLoad.size();
+  conComponentNum = count(isConComponent.begin(), isConComponent.end(), true);
+  size_t groupNum = min(max(conComponentNum, (size_t)1), max(_maxGroupNum, (size_t)1));
+
+  // 最长处理时间优先：分量按规模降序依次放入当前负载最小的组；
+  // 无约束分量不单独占组，排在最后补入负载最小的组
+  vector<size_t> componentOrder(componentNum);
+  for (size_t componentIdx = 0; componentIdx < componentNum; ++componentIdx)
+    componentOrder[componentIdx] = componentIdx;
+  stable_sort(componentOrder.begin(), componentOrder.end(),
+              [&](size_t _lhs, size_t _rhs)
+              {
+                if (isConComponent[_lhs] != isConComponent[_rhs])
+                  return (bool)isConComponent[_lhs];
+                return componentLoad[_lhs] > componentLoad[_rhs];
+              });
+  vector<size_t> componentGroup(componentNum);
+  vector<size_t> groupLoad(groupNum, 0);
+  for (size_t componentIdx : componentOrder)
+  {
+    size_t groupIdx = min_element(groupLoad.begin(), groupLoad.end()) - groupLoad.begin();
+    componentGroup[componentIdx] = groupIdx;
+    groupLoad[groupIdx] += componentLoad[componentIdx];
+  }
+
+  varGroup.resize(varNum);
+  varSubIdx.resize(varNum);
+  groupVarIdxs.assign(groupNum, vector<size_t>());
+  for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+  {
+    size_t groupIdx = componentGroup[rootComponent[Find(varIdx)]];
+    varGroup[varIdx] = groupIdx;
+    varSubIdx[varIdx] = groupVarIdxs[groupIdx].size();
+    groupVarIdxs[groupIdx].push_back(varIdx);
+  }
+  vector<vector<size_t>> groupConIdxs(groupNum);
+  for (size_t conIdx = 1; conIdx < conNum; ++conIdx)
+  {
+    const auto &modelCon = modelConUtil->conSet[conIdx];
+    if (modelCon.termNum > 0)
+      groupConIdxs[varGroup[modelCon.varIdxSet[0]]].push_back(conIdx);
+  }
+  for (size_t groupIdx = 0; groupIdx < groupNum; ++groupIdx)
+    BuildGroup(groupIdx, groupConIdxs[groupIdx]);
+  return groupNum;
+}
+
+// 子模型沿用原模型的变量、约束与类型；常数项只计入第 0 组，各组目标值之和即为原目标值
+void Decomposer::BuildGroup(
+    size_t _groupIdx,
+    const vector<size_t> &_conIdxs)
+{
+  auto *conUtil = new ModelConUtil();
+  auto *varUtil = new ModelVarUtil();
+  groupConUtils.push_back(conUtil);
+  groupVarUtils.push_back(varUtil);
+  const auto &varIdxs = groupVarIdxs[_groupIdx];
+  size_t varNum = varIdxs.size();
+  size_t conNum = _conIdxs.size() + 1;
+
+  conUtil->MIN = modelConUtil->MIN;
+  conUtil->isIntegral = modelConUtil->isIntegral;
+  conUtil->objName = modelConUtil->objName;
+  conUtil->conSet.push_back(modelConUtil->conSet[0]);
+  for (size_t conIdx : _conIdxs)
+  {
+    conUtil->conSet.push_back(modelConUtil->conSet[conIdx]);
+    conUtil->conSet.back().idx = conUtil->conSet.size() - 1;
+  }
+  for (size_t subIdx = 0; subIdx < varNum; ++subIdx)
+  {
+    varUtil->varSet.push_back(modelVarUtil->varSet[varIdxs[subIdx]]);
+    auto &modelVar = varUtil->varSet.back();
+    modelVar.idx = subIdx;
+    if (modelVar.type == VarType::Fixed)
+      varUtil->fixedNum++;
+    else if (modelVar.type == VarType::Binary)
+      varUtil->binaryNum++;
+    else if (modelVar.type == VarType::Integer)
+      varUtil->integerNum++;
+    else
+      varUtil->realNum++;
+  }
+  varUtil->isBin = varUtil->integerNum == 0 && varUtil->realNum == 0;
+  varUtil->objBias = _groupIdx == 0 ? modelVarUtil->objBias : 0;
+  conUtil->conNum = conNum;
+  varUtil->varNum = varNum;
+
+  // CSR：目标函数只保留组内变量的项，其余约束整行属于本组
+  auto &conBegin = conUtil->termBegin;
+  conBegin.assign(conNum + 1, 0);
+  for (size_t subConIdx = 0; subConIdx < conNum; ++subConIdx)
+  {
+    const auto &modelCon = modelConUtil->conSet[subConIdx == 0 ? 0 : _conIdxs[subConIdx - 1]];
+    for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+    {
+      size_t varIdx = modelCon.varIdxSet[termIdx];
+      if (varGroup[varIdx] != _groupIdx)
+        continue;
+      conUtil->termVarIdxs.push_back(varSubIdx[varIdx]);
+      conUtil->termCoeffs.push_back(modelCon.coeffSet[termIdx]);
+    }
+    conBegin[subConIdx + 1] = conUtil->termVarIdxs.size();
+  }
+  size_t termNum = conUtil->termVarIdxs.size();
+  conUtil->termPosInVar.resize(termNum);
+
+  // CSC：按约束顺序填充，保证每列内约束下标递增（目标函数总在首位）
+  auto &varBegin = varUtil->termBegin;
+  varBegin.assign(varNum + 1, 0);
+  for (size_t pos = 0; pos < termNum; ++pos)
+    ++varBegin[conUtil->termVarIdxs[pos] + 1];
+  for (size_t subIdx = 0; subIdx < varNum; ++subIdx)
+    varBegin[subIdx + 1] += varBegin[subIdx];
+  varUtil->termConIdxs.resize(termNum);
+  varUtil->termCoeffs.resize(termNum);
+  varUtil->termPosInCon.resize(termNum);
+  vector<size_t> fill(varBegin.begin(), varBegin.end() - 1);
+  for (size_t subConIdx = 0; subConIdx < conNum; ++subConIdx)
+    for (size_t pos = conBegin[subConIdx]; pos < conBegin[subConIdx + 1]; ++pos)
+    {
+      size_t subVarIdx = conUtil->termVarIdxs[pos];
+      size_t varPos = fill[subVarIdx]++;
+      varUtil->termConIdxs[varPos] = subConIdx;
+      varUtil->termCoeffs[varPos] = conUtil->termCoeffs[pos];
+      varUtil->termPosInCon[varPos] = pos - conBegin[subConIdx];
+      conUtil->termPosInVar[pos] = varPos - varBegin[subVarIdx];
+    }
+  conUtil->LinkTerms();
+  varUtil->LinkTerms();
+
+  varUtil->varIdx2ObjIdx.resize(varNum, -1);
+  const auto &subObj = conUtil->conSet[0];
+  for (size_t termIdx = 0; termIdx < subObj.termNum; ++termIdx)
+    varUtil->varIdx2ObjIdx[subObj.varIdxSet[termIdx]] = termIdx;
+}
@@ -0,0 +1,55 @@
+/*=====================================================================================
+
+    Filename:     Decomposer.h
+
+    Description:  Connected components of the constraint-variable graph
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#pragma once
+#include "utils/paras.h"
+#include "ModelCon.h"
+#include "ModelVar.h"
+
+// 不计目标函数时，共享约束的变量属于同一连通分量；
+// 分量按规模装箱为若干组，每组构成一个独立的子模型（目标函数只保留组内变量的项）
+class Decomposer
+{
+private:
+  const ModelConUtil *modelConUtil;
+  const ModelVarUtil *modelVarUtil;
+  vector<size_t> parent;
+  vector<size_t> setSize;
+  size_t Find(
+      size_t _varIdx);
+  void Union(
+      size_t _varIdx1,
+      size_t _varIdx2);
+  void BuildGroup(
+      size_t _groupIdx,
+      const vector<size_t> &_conIdxs);
+
+public:
+  size_t componentNum;
+  size_t conComponentNum;
+  vector<size_t> varGroup;
+  vector<size_t> varSubIdx;
+  vector<vector<size_t>> groupVarIdxs;
+  vector<ModelConUtil *> groupConUtils;
+  vector<ModelVarUtil *> groupVarUtils;
+
+  Decomposer(
+      const ModelConUtil *_modelConUtil,
+      const ModelVarUtil *_modelVarUtil);
+  ~Decomposer();
+  size_t Decompose(
+      size_t _maxGroupNum);
+};
@@ -17,9 +17,10 @@
 #include "LocalCon.h"
 
 LocalCon::LocalCon()
-    : weight(1),
+    : LHS(0),
       RHS(0),
-      LHS(0)
+      lowerRHS(NegativeInfinity),
+      weight(1)
 {
 }
 
@@ -29,12 +30,18 @@ LocalCon::~LocalCon()
 
 bool LocalCon::SAT()
 {
-  return LHS < RHS + FeasibilityTol;
+  return LHS < RHS + FeasibilityTol && LHS > lowerRHS - FeasibilityTol;
 }
 
 bool LocalCon::UNSAT()
 {
-  return LHS >= RHS + FeasibilityTol;
+  return LHS >= RHS + FeasibilityTol || LHS <= lowerRHS - FeasibilityTol;
+}
+
+// 违反的是下界一侧
+bool LocalCon::BelowLower() const
+{
+  return LHS <= lowerRHS - FeasibilityTol;
 }
 
 LocalConUtil::LocalConUtil()
@@ -48,6 +55,10 @@ void LocalConUtil::Allocate(
   tempSatConIdxs.reserve(_conNum);
   tempUnsatConIdxs.reserve(_conNum);
   conSet.resize(_conNum);
+  posInUnsatConIdxs.resize(_conNum);
+  lowerWeights.resize(_conNum, 1);
+  sampleStamp.resize(_conNum, 0);
+  sampleEpoch = 0;
 }
 
 LocalConUtil::~LocalConUtil()
@@ -55,7 +66,10 @@ LocalConUtil::~LocalConUtil()
   tempSatConIdxs.clear();
   tempUnsatConIdxs.clear();
   conSet.clear();
+  posInUnsatConIdxs.clear();
+  lowerWeights.clear();
   unsatConIdxs.clear();
+  sampleStamp.clear();
 }
 
 LocalCon &LocalConUtil::GetCon(
@@ -67,7 +81,7 @@ LocalCon &LocalConUtil::GetCon(
 void LocalConUtil::insertUnsat(
     const size_t _conIdx)
 {
-  conSet[_conIdx].posInUnsatConIdxs = unsatConIdxs.size();
+  posInUnsatConIdxs[_conIdx] = unsatConIdxs.size();
   unsatConIdxs.push_back(_conIdx);
 }
 
@@ -80,8 +94,8 @@ void LocalConUtil::RemoveUnsat(
     unsatConIdxs.pop_back();
     return;
   }
-  size_t pos = conSet[_conIdx].posInUnsatConIdxs;
+  size_t pos = posInUnsatConIdxs[_conIdx];
   unsatConIdxs[pos] = *unsatConIdxs.rbegin();
   unsatConIdxs.pop_back();
-  conSet[unsatConIdxs[pos]].posInUnsatConIdxs = pos;
+  posInUnsatConIdxs[unsatConIdxs[pos]] = pos;
 }
\ No newline at end of file
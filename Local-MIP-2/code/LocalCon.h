@@ -17,28 +17,68 @@
 #pragma once
 #include "utils/paras.h"
 
+// 只保留打分与移动时逐行访问的热字段（32 字节），posInUnsatConIdxs 与下界一侧的权重
+// lowerWeights 移到 LocalConUtil；区间约束的两侧各有权重，只增加被违反一侧的权重；
+// 单侧约束的 lowerRHS 为负无穷，下界一侧恒满足且稳定，不影响评分，也不读取 lowerWeights
 class LocalCon
 {
 public:
-  size_t weight;
-  size_t posInUnsatConIdxs;
-  Value RHS;
   Value LHS;
+  Value RHS;
+  Value lowerRHS;
+  size_t weight;
 
   LocalCon();
   ~LocalCon();
   bool SAT();
   bool UNSAT();
+  bool BelowLower() const;
+
+  // 一侧 LHS <= _RHS 的评分：满足性变化记 ±w，一直违反时按是否更接近记 ±w/2，
+  // 稳定性变化计入子评分；下界一侧以取反的 (LHS, newLHS, lowerRHS) 调用
+  static long SideScore(
+      Value _LHS,
+      Value _newLHS,
+      Value _RHS,
+      size_t _weight,
+      long &_subscore)
+  {
+    long score = 0;
+    bool isPreSat = _LHS < _RHS + FeasibilityTol;
+    bool isNowSat = _newLHS < _RHS + FeasibilityTol;
+    if (!isPreSat && isNowSat)
+      score += _weight;
+    else if (isPreSat && !isNowSat)
+      score -= _weight;
+    else if (!isPreSat && !isNowSat)
+    {
+      if (_LHS > _newLHS)
+        score += _weight >> 1;
+      else
+        score -= _weight >> 1;
+    }
+
+    bool isPreStable = _LHS < _RHS - FeasibilityTol;
+    bool isNowStable = _newLHS < _RHS - FeasibilityTol;
+    if (!isPreStable && isNowStable)
+      _subscore += _weight;
+    else if (isPreStable && !isNowStable)
+      _subscore -= _weight;
+    return score;
+  }
 };
 
 class LocalConUtil
 {
 public:
   vector<LocalCon> conSet;
+  vector<Index> posInUnsatConIdxs;
+  vector<size_t> lowerWeights;
   vector<size_t> unsatConIdxs;
   vector<size_t> tempUnsatConIdxs;
   vector<size_t> tempSatConIdxs;
-  unordered_set<size_t> sampleSet;
+  vector<size_t> sampleStamp;
+  size_t sampleEpoch;
 
   LocalConUtil();
   ~LocalConUtil();
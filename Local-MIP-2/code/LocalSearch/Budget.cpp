@@ -0,0 +1,89 @@
+/*=====================================================================================
+
+    Filename:     Budget.cpp
+
+    Description:  Online rescaling of the sampling and BMS budgets
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "LocalMIP.h"
+
+void LocalMIP::InitBudget()
+{
+  baseSampleUnsat = sampleUnsat;
+  baseBmsUnsatInfeas = bmsUnsatInfeas;
+  baseBmsUnsatFeas = bmsUnsatFeas;
+  baseSampleSat = sampleSat;
+  baseBmsSat = bmsSat;
+  baseBmsFlip = bmsFlip;
+  baseBmsRandom = bmsRandom;
+  budgetDirection = -1;
+  nextBudgetStep = budgetEpoch;
+  epochStartStep = 0;
+  epochStartUnsatNum = std::numeric_limits<size_t>::max();
+  bestUnsatNum = std::numeric_limits<size_t>::max();
+  epochStartBestOBJ = Infinity;
+  lastEpochGainRate = -1;
+  lastEpochStepRate = -1;
+  epochStartTime = TimeNow();
+  ApplyBudgetScale();
+}
+
+// 所有预算按同一比例缩放，至少保留 1
+void LocalMIP::ApplyBudgetScale()
+{
+  auto scaled = [&](size_t _base)
+  { return max((size_t)1, (size_t)llround(_base * budgetScale)); };
+  sampleUnsat = scaled(baseSampleUnsat);
+  bmsUnsatInfeas = scaled(baseBmsUnsatInfeas);
+  bmsUnsatFeas = scaled(baseBmsUnsatFeas);
+  sampleSat = scaled(baseSampleSat);
+  bmsSat = scaled(baseBmsSat);
+  bmsFlip = scaled(baseBmsFlip);
+  bmsRandom = scaled(baseBmsRandom);
+}
+
+// 爬山法：每个周期比较单位时间的改进量（可行前为最少不满足约束数的下降，
+// 可行后为最优目标的相对改进）；两个周期都无改进时比较每秒步数。
+// 变好则沿原方向继续缩放，否则反向
+void LocalMIP::AdaptBudget()
+{
+  auto clkNow = TimeNow();
+  double seconds = max(chrono::duration<double>(clkNow - epochStartTime).count(), 1e-6);
+  double gain = 0;
+  if (epochStartUnsatNum != std::numeric_limits<size_t>::max())
+    gain += (double)(epochStartUnsatNum - bestUnsatNum);
+  if (isFoundFeasible && epochStartBestOBJ < Infinity)
+    gain += (epochStartBestOBJ - bestOBJ) / (fabs(epochStartBestOBJ) + 1);
+  double gainRate = gain / seconds;
+  double stepRate = (curStep - epochStartStep) / seconds;
+
+  bool isBetter =
+      gainRate > lastEpochGainRate ||
+      (gainRate == 0 && lastEpochGainRate == 0 && stepRate > lastEpochStepRate);
+  if (!isBetter)
+    budgetDirection = -budgetDirection;
+  budgetScale *= budgetDirection > 0 ? 1.25 : 0.8;
+  budgetScale = min(max(budgetScale, budgetMinScale), budgetMaxScale);
+  ApplyBudgetScale();
+  printf("c budget step %ld; scale %.3lf; gain/s %.4lf; steps/s %.0lf; "
+         "sampleUnsat %ld; bmsUnsat %ld/%ld; sampleSat %ld; bmsSat %ld; bmsFlip %ld; bmsRandom %ld\n",
+         curStep, budgetScale, gainRate, stepRate,
+         sampleUnsat, bmsUnsatInfeas, bmsUnsatFeas, sampleSat, bmsSat, bmsFlip, bmsRandom);
+
+  lastEpochGainRate = gainRate;
+  lastEpochStepRate = stepRate;
+  epochStartUnsatNum = bestUnsatNum;
+  epochStartBestOBJ = bestOBJ;
+  epochStartStep = curStep;
+  epochStartTime = clkNow;
+  nextBudgetStep = curStep + budgetEpoch;
+}
@@ -0,0 +1,152 @@
+/*=====================================================================================
+
+    Filename:     FlipEngine.cpp
+
+    Description:  Incremental make/break flip scores for pure binary models
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "LocalMIP.h"
+
+// 单个约束对翻转评分的贡献，与 TightScore 中普通约束的逻辑一致
+static long FlipConScore(
+    Value _LHS,
+    const LocalCon &_localCon,
+    size_t _weight,
+    size_t _lowerWeight,
+    Value _coeffDelta,
+    long &_subscore)
+{
+  Value newLHS = _LHS + _coeffDelta;
+  long score = LocalCon::SideScore(_LHS, newLHS, _localCon.RHS, _weight, _subscore);
+  if (_localCon.lowerRHS != NegativeInfinity)
+    score += LocalCon::SideScore(
+        -_LHS, -newLHS, -_localCon.lowerRHS, _lowerWeight, _subscore);
+  return score;
+}
+
+// 目标函数项的符号部分：只与变量当前取值和目标权重有关，与目标 LHS 无关
+long LocalMIP::FlipObjScore(
+    const ModelVar &_modelVar,
+    size_t _objWeight)
+{
+  if (!isFoundFeasible ||
+      _modelVar.termNum == 0 || _modelVar.conIdxSet[0] != 0)
+    return 0;
+  Value delta = localVarUtil.GetValueBit(_modelVar.idx) ? -1 : 1;
+  if (_modelVar.coeffSet[0] * delta < 0)
+    return _objWeight;
+  return -(long)_objWeight;
+}
+
+void LocalMIP::RescoreFlipVar(
+    size_t _varIdx)
+{
+  const auto &modelVar = modelVarUtil->GetVar(_varIdx);
+  Value delta = localVarUtil.GetValueBit(_varIdx) ? -1 : 1;
+  long score = FlipObjScore(modelVar, localConUtil.conSet[0].weight);
+  long subscore = 0;
+  for (size_t termIdx = 0; termIdx < modelVar.termNum; ++termIdx)
+  {
+    size_t conIdx = modelVar.conIdxSet[termIdx];
+    if (conIdx == 0)
+      continue;
+    const auto &localCon = localConUtil.conSet[conIdx];
+    score += FlipConScore(
+        localCon.LHS, localCon, localCon.weight, localConUtil.lowerWeights[conIdx],
+        modelVar.coeffSet[termIdx] * delta, subscore);
+  }
+  localVarUtil.flipScore[_varIdx] = score;
+  localVarUtil.flipSubscore[_varIdx] = subscore;
+}
+
+void LocalMIP::InitFlipEngine()
+{
+  for (size_t varIdx : localVarUtil.binaryIdx)
+    localVarUtil.SetValueBit(varIdx, localVarUtil.GetVar(varIdx).nowValue > 0.5);
+  for (size_t varIdx : localVarUtil.binaryIdx)
+    RescoreFlipVar(varIdx);
+  localVarUtil.BuildFlipHeap();
+}
+
+// 约束 LHS 从 _oldLHS 变为 _newLHS 时，更新该约束中其它变量的翻转评分
+void LocalMIP::FlipEngineRowChange(
+    size_t _conIdx,
+    Value _oldLHS,
+    Value _newLHS,
+    size_t _movedVarIdx)
+{
+  const auto &localCon = localConUtil.conSet[_conIdx];
+  const auto &modelCon = modelConUtil->conSet[_conIdx];
+  for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+  {
+    size_t varIdx = modelCon.varIdxSet[termIdx];
+    if (varIdx == _movedVarIdx)
+      continue;
+    Value coeffDelta =
+        localVarUtil.GetValueBit(varIdx) ? -modelCon.coeffSet[termIdx] : modelCon.coeffSet[termIdx];
+    long newSubscore = 0;
+    long oldSubscore = 0;
+    long scoreChange =
+        FlipConScore(_newLHS, localCon, localCon.weight, localConUtil.lowerWeights[_conIdx],
+                     coeffDelta, newSubscore) -
+        FlipConScore(_oldLHS, localCon, localCon.weight, localConUtil.lowerWeights[_conIdx],
+                     coeffDelta, oldSubscore);
+    if (scoreChange == 0 && newSubscore == oldSubscore)
+      continue;
+    localVarUtil.flipScore[varIdx] += scoreChange;
+    localVarUtil.flipSubscore[varIdx] += newSubscore - oldSubscore;
+    localVarUtil.UpdateFlipHeap(varIdx);
+  }
+}
+
+// 约束两侧权重从 (_oldWeight, _oldLowerWeight) 变为当前值时，更新该约束中所有变量的翻转评分
+void LocalMIP::FlipEngineWeightChange(
+    size_t _conIdx,
+    size_t _oldWeight,
+    size_t _oldLowerWeight)
+{
+  const auto &localCon = localConUtil.conSet[_conIdx];
+  const auto &modelCon = modelConUtil->conSet[_conIdx];
+  for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+  {
+    size_t varIdx = modelCon.varIdxSet[termIdx];
+    Value coeffDelta =
+        localVarUtil.GetValueBit(varIdx) ? -modelCon.coeffSet[termIdx] : modelCon.coeffSet[termIdx];
+    long newSubscore = 0;
+    long oldSubscore = 0;
+    long scoreChange =
+        FlipConScore(localCon.LHS, localCon, localCon.weight, localConUtil.lowerWeights[_conIdx],
+                     coeffDelta, newSubscore) -
+        FlipConScore(localCon.LHS, localCon, _oldWeight, _oldLowerWeight,
+                     coeffDelta, oldSubscore);
+    if (scoreChange == 0 && newSubscore == oldSubscore)
+      continue;
+    localVarUtil.flipScore[varIdx] += scoreChange;
+    localVarUtil.flipSubscore[varIdx] += newSubscore - oldSubscore;
+    localVarUtil.UpdateFlipHeap(varIdx);
+  }
+}
+
+void LocalMIP::FlipEngineObjWeightChange(
+    size_t _oldWeight)
+{
+  const auto &modelObj = modelConUtil->conSet[0];
+  size_t objWeight = localConUtil.conSet[0].weight;
+  for (size_t termIdx = 0; termIdx < modelObj.termNum; ++termIdx)
+  {
+    size_t varIdx = modelObj.varIdxSet[termIdx];
+    const auto &modelVar = modelVarUtil->GetVar(varIdx);
+    localVarUtil.flipScore[varIdx] +=
+        FlipObjScore(modelVar, objWeight) - FlipObjScore(modelVar, _oldWeight);
+    localVarUtil.UpdateFlipHeap(varIdx);
+  }
+}
@@ -24,6 +24,23 @@ bool LocalMIP::FlipMove(
     if (localVarUtil.binaryIdx.size() == 0)  // 无二进制变量时直接返回
         return false;
 
+    // 纯 0-1 模型：直接取堆顶的最优翻转，处于禁忌期时退回随机采样
+    if (isFlipEngine) {
+        size_t varIdx = localVarUtil.flipHeap[0];
+        auto &localVar = localVarUtil.GetVar(varIdx);
+        Value delta = localVarUtil.GetValueBit(varIdx) ? -1 : 1;
+        if (localVarUtil.flipScore[varIdx] > 0 &&
+            !(delta < 0 && curStep < localVar.allowDecStep) &&
+            !(delta > 0 && curStep < localVar.allowIncStep)) {
+            if (DEBUG) printf("Heap flip: %-6ld; ", localVarUtil.flipScore[varIdx]);
+            ++flipStep;
+            ++heapFlipStep;
+            ApplyMove(varIdx, delta);
+            PickVar[varIdx]++;
+            return true;
+        }
+    }
+
     // 初始化最优解记录
     long bestScore = 0;
     long bestSubscore = -std::numeric_limits<long>::max();
@@ -33,7 +50,7 @@ bool LocalMIP::FlipMove(
     // 随机尝试bmsFlip次翻转
     for (size_t idx = 0; idx < bmsFlip; ++idx) {
         // 随机选择一个二进制变量
-        size_t varIdx = localVarUtil.binaryIdx[mt() % localVarUtil.binaryIdx.size()];
+        size_t varIdx = localVarUtil.binaryIdx[rng.Bounded(localVarUtil.binaryIdx.size())];
 
         // 跳过已评估的变量
         if (_scoreTable[varIdx]) continue;
@@ -0,0 +1,96 @@
+/*=====================================================================================
+
+    Filename:     IncumbentBoard.h
+
+    Description:  Best solution shared between portfolio search threads
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#pragma once
+#include "utils/paras.h"
+#include <memory>
+
+// 最优目标值为原子变量，可每步轮询；最优解由顺序锁保护：
+// 写者用 CAS 把序号置为奇数后写入，完成后置回偶数；读者在序号前后一致且为偶数时读取成功
+class IncumbentBoard
+{
+private:
+  std::atomic<Value> bestOBJ;
+  std::atomic<size_t> sequence;
+  std::unique_ptr<std::atomic<Value>[]> values;
+  size_t varNum;
+
+public:
+  IncumbentBoard(
+      size_t _varNum)
+      : bestOBJ(Infinity),
+        sequence(0),
+        values(new std::atomic<Value>[_varNum]),
+        varNum(_varNum)
+  {
+    for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+      values[varIdx].store(0, std::memory_order_relaxed);
+  }
+
+  // 目标值为 LocalMIP 内部（最小化）尺度
+  Value BestOBJ() const
+  {
+    return bestOBJ.load(std::memory_order_acquire);
+  }
+
+  // 仅当 _obj 严格优于当前记录时写入；_valueOf(varIdx) 给出各变量取值
+  template <typename ValueOf>
+  bool Publish(
+      Value _obj,
+      ValueOf _valueOf)
+  {
+    size_t seq = sequence.load(std::memory_order_relaxed);
+    while (true)
+    {
+      if (_obj >= BestOBJ())
+        return false;
+      if ((seq & 1) == 0 &&
+          sequence.compare_exchange_weak(
+              seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        break;
+      seq = sequence.load(std::memory_order_relaxed);
+    }
+    bool isBetter = _obj < bestOBJ.load(std::memory_order_relaxed);
+    if (isBetter)
+    {
+      std::atomic_thread_fence(std::memory_order_release);
+      for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+        values[varIdx].store(_valueOf(varIdx), std::memory_order_relaxed);
+      bestOBJ.store(_obj, std::memory_order_release);
+    }
+    sequence.store(seq + 2, std::memory_order_release);
+    return isBetter;
+  }
+
+  // 读取一致的最优解快照；尚无解时返回 false
+  bool Read(
+      vector<Value> &_values,
+      Value &_obj) const
+  {
+    while (true)
+    {
+      size_t seqBegin = sequence.load(std::memory_order_acquire);
+      if (seqBegin & 1)
+        continue;
+      _obj = bestOBJ.load(std::memory_order_relaxed);
+      for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+        _values[varIdx] = values[varIdx].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == seqBegin)
+        return _obj < Infinity;
+    }
+  }
+};
@@ -16,59 +16,86 @@
 
 #include "LocalMIP.h"
 
-bool LocalMIP::LiftMoveWithoutBreak()
+// 保持所有约束满足时变量可调整的区间；区间约束的两侧分别收紧
+void LocalMIP::LiftRange(
+    const ModelVar &_modelVar,
+    Value &_lowerDelta,
+    Value &_upperDelta)
 {
-  auto &localObj = localConUtil.conSet[0];
-  auto &modelObj = modelConUtil->conSet[0];
-  vector<Value> &lowerDelta = localVarUtil.lowerDeltaInLiftMove;
-  vector<Value> &upperDelta = localVarUtil.upperDeltaInLifiMove;
-  if (!isKeepFeas)
+  auto &localVar = localVarUtil.GetVar(_modelVar.idx);
+  _lowerDelta = _modelVar.lowerBound - localVar.nowValue;
+  _upperDelta = _modelVar.upperBound - localVar.nowValue;
+  for (size_t termIdx = 0; termIdx < _modelVar.termNum; ++termIdx)
   {
-    for (size_t termIdx = 0; termIdx < modelObj.termNum; ++termIdx)
+    size_t conIdx = _modelVar.conIdxSet[termIdx];
+    if (conIdx == 0)
+      continue;
+    auto &localCon = localConUtil.conSet[conIdx];
+    auto &modelCon = modelConUtil->conSet[conIdx];
+    size_t posInCon = _modelVar.posInCon[termIdx];
+    Value coeff = _modelVar.coeffSet[termIdx];
+    Value delta;
+    Value gap = localCon.LHS - localCon.RHS;
+    if (fabs(gap) < FeasibilityTol)
     {
-      size_t varIdx = modelObj.varIdxSet[termIdx];
-      auto &localVar = localVarUtil.GetVar(varIdx);
-      auto &modelVar = modelVarUtil->GetVar(varIdx);
-      lowerDelta[termIdx] = modelVar.lowerBound - localVar.nowValue;
-      upperDelta[termIdx] = modelVar.upperBound - localVar.nowValue;
-      for (size_t j = 0; j < modelVar.termNum; ++j)
+      if (coeff > 0)
+        _upperDelta = 0;
+      else
+        _lowerDelta = 0;
+    }
+    else if (TightDelta(localCon, modelCon, posInCon, false, delta))
+    {
+      if (coeff > 0)
       {
-        size_t conIdx = modelVar.conIdxSet[j];
-        auto &localCon = localConUtil.conSet[conIdx];
-        auto &modelCon = modelConUtil->conSet[conIdx];
-        size_t posInCon = modelVar.posInCon[j];
-        Value coeff = modelCon.coeffSet[posInCon];
-        if (conIdx == 0)
-          continue;
-        Value delta;
-        Value gap = localCon.LHS - localCon.RHS;
-        if (fabs(gap) < FeasibilityTol)
+        if (delta < _upperDelta)
+          _upperDelta = delta;
+      }
+      else if (coeff < 0)
+      {
+        if (delta > _lowerDelta)
+          _lowerDelta = delta;
+      }
+    }
+    if (localCon.lowerRHS != NegativeInfinity)
+    {
+      gap = localCon.LHS - localCon.lowerRHS;
+      if (fabs(gap) < FeasibilityTol)
+      {
+        if (coeff > 0)
+          _lowerDelta = 0;
+        else
+          _upperDelta = 0;
+      }
+      else if (TightDelta(localCon, modelCon, posInCon, true, delta))
+      {
+        if (coeff > 0)
         {
-          if (coeff > 0)
-            upperDelta[termIdx] = 0;
-          else
-            lowerDelta[termIdx] = 0;
+          if (delta > _lowerDelta)
+            _lowerDelta = delta;
         }
-        else if (!TightDelta(localCon, modelCon, posInCon, delta))
-          continue;
-        else
+        else if (coeff < 0)
         {
-          if (coeff > 0)
-          {
-            if (delta < upperDelta[termIdx])
-              upperDelta[termIdx] = delta;
-          }
-          else if (coeff < 0)
-          {
-            if (delta > lowerDelta[termIdx])
-              lowerDelta[termIdx] = delta;
-          }
+          if (delta < _upperDelta)
+            _upperDelta = delta;
         }
-        if (lowerDelta[termIdx] >= upperDelta[termIdx])
-          break;
       }
     }
+    if (_lowerDelta >= _upperDelta)
+      break;
   }
+}
+
+bool LocalMIP::LiftMoveWithoutBreak()
+{
+  auto &localObj = localConUtil.conSet[0];
+  auto &modelObj = modelConUtil->conSet[0];
+  vector<Value> &lowerDelta = localVarUtil.lowerDeltaInLiftMove;
+  vector<Value> &upperDelta = localVarUtil.upperDeltaInLifiMove;
+  if (!isKeepFeas)
+    for (size_t termIdx = 0; termIdx < modelObj.termNum; ++termIdx)
+      LiftRange(
+          modelVarUtil->GetVar(modelObj.varIdxSet[termIdx]),
+          lowerDelta[termIdx], upperDelta[termIdx]);
   Value bestObjDelta = 0;
   size_t bestVarIdx = -1;
   Value bestVarDelta = 0;
@@ -76,8 +103,6 @@ bool LocalMIP::LiftMoveWithoutBreak()
   Value objDelta;
   Value objDelta_l;
   Value objDelta_u;
-  vector<size_t> betterIdx;
-  vector<Value> betterDelta;
   size_t bestLastMoveStep = std::numeric_limits<size_t>::max();
   for (size_t termIdx = 0; termIdx < modelObj.termNum; ++termIdx)
   {
@@ -115,11 +140,6 @@ bool LocalMIP::LiftMoveWithoutBreak()
       bestVarDelta = varDelta;
       bestLastMoveStep = lastMoveStep;
     }
-    // if (objDelta < 0)
-    // {
-    //   betterIdx.push_back(varIdx);
-    //   betterDelta.push_back(varDelta);
-    // }
   }
 
   if (bestVarIdx != -1 && bestVarDelta != 0)
@@ -127,64 +147,34 @@ bool LocalMIP::LiftMoveWithoutBreak()
     ++liftStep;
     ApplyMove(bestVarIdx, bestVarDelta);
     isKeepFeas = true;
-    unordered_set<size_t> &affectedVar = localVarUtil.affectedVar;
-    affectedVar.clear();
+    vector<size_t> &affectedVarIdxs = localVarUtil.affectedVarIdxs;
+    vector<size_t> &affectedStamp = localVarUtil.affectedStamp;
+    size_t affectedEpoch = ++localVarUtil.affectedEpoch;
+    affectedVarIdxs.clear();
     auto &bestLocalVar = localVarUtil.GetVar(bestVarIdx);
     auto &bestModelVar = modelVarUtil->GetVar(bestVarIdx);
-    for (auto conIdx : bestModelVar.conIdxSet)
+    for (size_t termIdx = 0; termIdx < bestModelVar.termNum; ++termIdx)
     {
+      size_t conIdx = bestModelVar.conIdxSet[termIdx];
       if (conIdx == 0)
         continue;
       auto &localCon = localConUtil.GetCon(conIdx);
       auto &modelCon = modelConUtil->GetCon(conIdx);
-      for (auto varIdx : modelCon.varIdxSet)
-        affectedVar.insert(varIdx);
+      for (size_t conTermIdx = 0; conTermIdx < modelCon.termNum; ++conTermIdx)
+      {
+        size_t varIdx = modelCon.varIdxSet[conTermIdx];
+        if (affectedStamp[varIdx] == affectedEpoch)
+          continue;
+        affectedStamp[varIdx] = affectedEpoch;
+        affectedVarIdxs.push_back(varIdx);
+      }
     }
-    for (auto varIdx : affectedVar)
+    for (auto varIdx : affectedVarIdxs)
     {
       size_t idxInObj = modelVarUtil->varIdx2ObjIdx[varIdx];
       if (idxInObj == -1)
         continue;
-      auto &localVar = localVarUtil.GetVar(varIdx);
-      auto &modelVar = modelVarUtil->GetVar(varIdx);
-      lowerDelta[idxInObj] = modelVar.lowerBound - localVar.nowValue;
-      upperDelta[idxInObj] = modelVar.upperBound - localVar.nowValue;
-      for (size_t termIdx = 0; termIdx < modelVar.termNum; ++termIdx)
-      {
-        size_t conIdx = modelVar.conIdxSet[termIdx];
-        auto &localCon = localConUtil.conSet[conIdx];
-        auto &modelCon = modelConUtil->conSet[conIdx];
-        size_t posInCon = modelVar.posInCon[termIdx];
-        Value coeff = modelCon.coeffSet[posInCon];
-        if (conIdx == 0)
-          continue;
-        Value delta;
-        Value gap = localCon.LHS - localCon.RHS;
-        if (fabs(gap) < FeasibilityTol)
-        {
-          if (coeff > 0)
-            upperDelta[idxInObj] = 0;
-          else
-            lowerDelta[idxInObj] = 0;
-        }
-        else if (!TightDelta(localCon, modelCon, posInCon, delta))
-          continue;
-        else
-        {
-          if (coeff > 0)
-          {
-            if (delta < upperDelta[idxInObj])
-              upperDelta[idxInObj] = delta;
-          }
-          else if (coeff < 0)
-          {
-            if (delta > lowerDelta[idxInObj])
-              lowerDelta[idxInObj] = delta;
-          }
-        }
-        if (lowerDelta[idxInObj] >= upperDelta[idxInObj])
-          break;
-      }
+      LiftRange(modelVarUtil->GetVar(varIdx), lowerDelta[idxInObj], upperDelta[idxInObj]);
     }
     return true;
   }
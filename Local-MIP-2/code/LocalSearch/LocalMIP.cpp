@@ -21,15 +21,43 @@ int LocalMIP::LocalSearch(
     Value _optimalObj,
     chrono::_V2::system_clock::time_point _clkStart)
 {
+  auto clkSearch = TimeNow();
+  lastClockCheck = clkSearch;
   Allocate();          // 分配内存和初始化数据结构
   InitSolution();      // 初始化解
   InitState();         // 初始化约束状态
+  if (isFlipEngine)
+    InitFlipEngine();    // 初始化翻转评分与堆
   auto &localObj = localConUtil.conSet[0];
   curStep = 0;
   time_t start,stop;
   start=time(NULL);
+#ifdef LMIP_ALLOC_CHECK
+  size_t stepAllocNum = AllocCount();
+#endif
   while (true)
   {
+#ifdef LMIP_ALLOC_CHECK
+    // 稳态下主循环不应有任何堆分配
+    assert(AllocCount() == stepAllocNum);
+#endif
+    // 周期性全量重算 LHS，抑制增量更新的浮点漂移；整数引擎下的增量更新精确，无需重算
+    if (isIncLHS && !isIntEngine && recomputeLHSStep > 0 &&
+        curStep > 0 && curStep % recomputeLHSStep == 0)
+      RecomputeLHS();
+
+    // 其它线程找到更优解时收紧目标约束，长期停滞时导入共享最优解
+    if (incumbentBoard != nullptr)
+      PollIncumbentBoard();
+
+    // 按实测吞吐与改进速率周期性调整采样预算
+    if (isAdaptBudget)
+    {
+      bestUnsatNum = min(bestUnsatNum, localConUtil.unsatConIdxs.size());
+      if (curStep >= nextBudgetStep)
+        AdaptBudget();
+    }
+
     if (DEBUG)
       printf("\nc UNSAT Size: %-10ld; ", localConUtil.unsatConIdxs.size());
 
@@ -43,29 +71,45 @@ int LocalMIP::LocalSearch(
         if (!isFoundFeasible) {
           stop=time(NULL);
           printf("Time: %ld\n",stop-start);
+          isFoundFeasible = true;
+          if (isFlipEngine)
+            InitFlipEngine(); // 目标项开始计入翻转评分
         }
-        isFoundFeasible = true;
       }
 
-      bool res = LiftMoveWithoutBreak(); // 尝试提升移动
+      bool res = scheduler == FixedChain && LiftMoveWithoutBreak(); // 尝试提升移动
       if (GetObjValue() <= _optimalObj) // 如果达到最优解
+      {
+        searchTime = ElapsedTime(TimeNow(), clkSearch);
         return 1;
+      }
 
-      ++curStep;
-      if (Timeout(_clkStart)) // 检查超时
-        break;
-      if (res)
-        continue;
+      if (scheduler == FixedChain)
+      {
+        ++curStep;
+        if (Timeout(_clkStart)) // 检查超时
+          break;
+        if (res)
+          continue;
+      }
     }
 
     if (Timeout(_clkStart))
       break;
 
+    // 由调度器按收益选择算子
+    if (scheduler != FixedChain)
+    {
+      ScheduledStep();
+      ++curStep;
+      continue;
+    }
+
     // 尝试不满足约束的紧致移动
     if (!UnsatTightMove())
     {
       // 根据概率更新权重或平滑权重
-      if (mt() % 10000 > smoothProbability)
+      if (rng.Bounded(10000) > smoothProbability)
         UpdateWeight();
       else
         SmoothWeight();
@@ -74,28 +118,85 @@ int LocalMIP::LocalSearch(
     }
     ++curStep;
   }
+  searchTime = ElapsedTime(TimeNow(), clkSearch);
   return 0; // 返回未找到最优解
 }
 
+// 预算检查：工作量与停止标志每步检查；时钟每 clockCheckInterval 步读一次，
+// 间隔按实际耗时自适应，使两次读时钟相隔约 1 毫秒
 bool LocalMIP::Timeout(
     chrono::_V2::system_clock::time_point &_clkStart)
 {
-  auto clk_now = chrono::high_resolution_clock::now();
-  auto solve_time =
-      chrono::duration_cast<chrono::seconds>(clk_now - _clkStart).count();
-  if (solve_time >= OPT(cutoff)) // 检查是否超过截止时间
+  if (workLimit > 0 && workUnits >= workLimit)
     return true;
+  if (stopFlag.load(std::memory_order_relaxed))
+    return true;
+  if (curStep < nextClockStep)
+    return false;
+  auto clkNow = TimeNow();
+  double checkGap = chrono::duration<double>(clkNow - lastClockCheck).count();
+  lastClockCheck = clkNow;
+  if (checkGap < 0.5e-3 && clockCheckInterval < 65536)
+    clockCheckInterval <<= 1;
+  else if (checkGap > 2e-3 && clockCheckInterval > 1)
+    clockCheckInterval >>= 1;
+  nextClockStep = curStep + clockCheckInterval;
+  if (chrono::duration<double>(clkNow - _clkStart).count() >= OPT(cutoff)) // 检查是否超过截止时间
+  {
+    stopFlag.store(true, std::memory_order_relaxed);
+    return true;
+  }
   return false;
 }
 
+void LocalMIP::Stop()
+{
+  stopFlag.store(true, std::memory_order_relaxed);
+}
+
+void LocalMIP::SetPortfolioSlot(
+    size_t _slot)
+{
+  portfolioSlot = _slot;
+}
+
+void LocalMIP::SetIncumbentBoard(
+    IncumbentBoard *_incumbentBoard)
+{
+  incumbentBoard = _incumbentBoard;
+}
+
+// 作为子模型求解时由上层汇总目标值并输出
+void LocalMIP::SetLogObj(
+    bool _isLogObj)
+{
+  isLogObj = _isLogObj;
+}
+
+bool LocalMIP::IsFoundFeasible()
+{
+  return isFoundFeasible;
+}
+
+Value LocalMIP::GetBestOBJ()
+{
+  return bestOBJ;
+}
+
+size_t LocalMIP::GetStepNum()
+{
+  return curStep;
+}
+
 void LocalMIP::LogObj(
     chrono::_V2::system_clock::time_point &_clkStart)
 {
   auto clk = TimeNow();
-  printf(
-      "n %-20f %lf\n",
-      (GetObjValue()),
-      ElapsedTime(clk, _clkStart)); // 打印目标函数值和运行时间
+  if (isLogObj)
+    printf(
+        "n %-20f %lf\n",
+        (GetObjValue()),
+        ElapsedTime(clk, _clkStart)); // 打印目标函数值和运行时间
   RunTime=ElapsedTime(clk, _clkStart);
 }
 
@@ -139,6 +240,22 @@ void LocalMIP::PrintResult()
   }
   else
     cout << "solution verify failed." << endl;
+  printf("c steps: %ld; steps/sec: %.0lf\n",
+         curStep, searchTime > 0 ? curStep / searchTime : 0.0);
+  if (isFlipEngine)
+    printf("c flip engine: %ld heap flips\n", heapFlipStep);
+  printf("c work units: %ld\n", workUnits);
+  if (scoreThreadNum > 1)
+    printf("c parallel scoring: %ld steps on %ld threads\n", parallelScoreNum, scoreThreadNum);
+  if (scheduler != FixedChain)
+    PrintOperatorStats();
+  if (incumbentBoard != nullptr)
+    printf("c incumbent board: %ld objective tightenings; %ld imports\n",
+           boardTightenNum, boardImportNum);
+  if (isScoreCache)
+    printf("c score cache: %ld hits / %ld lookups\n", cacheHitNum, cacheLookupNum);
+  if (isIncLHS)
+    printf("c LHS drift: %ld recomputed rows; max drift %e\n", driftConNum, maxDrift);
   save_result((char *)OPT(log).c_str(),win,RunTime,bestOBJ);
 }
 
@@ -171,12 +288,18 @@ void LocalMIP::InitState()
 void LocalMIP::UpdateBestSolution()
 {
   lastImproveStep = curStep;
-  for (auto &localVar : localVarUtil.varSet)
-    localVar.bestValue = localVar.nowValue; // 保存当前解为最优解
+  for (size_t varIdx = 0; varIdx < modelVarUtil->varNum; varIdx++)
+    localVarUtil.GetHistory(varIdx).bestValue =
+        localVarUtil.GetVar(varIdx).nowValue; // 保存当前解为最优解
   auto &localObj = localConUtil.conSet[0];
   auto &modelObj = modelConUtil->conSet[0];
   bestOBJ = localObj.LHS;
   localObj.RHS = bestOBJ - OptimalTol; // 更新目标函数的右侧值
+  if (incumbentBoard != nullptr)
+    incumbentBoard->Publish(
+        bestOBJ,
+        [&](size_t _varIdx)
+        { return localVarUtil.GetHistory(_varIdx).bestValue; });
 }
 
 void LocalMIP::ApplyMove(
@@ -186,26 +309,34 @@ void LocalMIP::ApplyMove(
   auto &localVar = localVarUtil.GetVar(_varIdx);
   auto &modelVar = modelVarUtil->GetVar(_varIdx);
   localVar.nowValue += _delta; // 更新变量值
+  workUnits += modelVar.termNum;
 
   // 更新相关约束的状态
   for (size_t termIdx = 0; termIdx < modelVar.termNum; ++termIdx)
   {
     size_t conIdx = modelVar.conIdxSet[termIdx];
-    size_t posInCon = modelVar.posInCon[termIdx];
     auto &localCon = localConUtil.conSet[conIdx];
     auto &modelCon = modelConUtil->conSet[conIdx];
     Value newLHS = 0;
-    for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
-      newLHS +=
-          modelCon.coeffSet[termIdx] *
-          localVarUtil.GetVar(modelCon.varIdxSet[termIdx]).nowValue;
+    if (isIncLHS)
+      newLHS = localCon.LHS + modelVar.coeffSet[termIdx] * _delta; // 增量更新
+    else
+      for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+        newLHS +=
+            modelCon.coeffSet[termIdx] *
+            localVarUtil.GetVar(modelCon.varIdxSet[termIdx]).nowValue;
 
     if (conIdx == 0)
       localCon.LHS = newLHS; // 更新目标函数
     else
     {
+      if (isScoreCache)
+        InvalidateScoreCache(conIdx);
+      if (isFlipEngine)
+        FlipEngineRowChange(conIdx, localCon.LHS, newLHS, _varIdx);
       bool isPreSat = localCon.SAT();
-      bool isNowSat = newLHS < localCon.RHS + FeasibilityTol;
+      bool isNowSat = newLHS < localCon.RHS + FeasibilityTol &&
+                      newLHS > localCon.lowerRHS - FeasibilityTol;
       if (isPreSat && !isNowSat)
         localConUtil.insertUnsat(conIdx); // 标记不满足的约束
       else if (!isPreSat && isNowSat)
@@ -215,41 +346,88 @@ void LocalMIP::ApplyMove(
     }
   }
 
+  if (isFlipEngine)
+  {
+    localVarUtil.FlipValueBit(_varIdx);
+    RescoreFlipVar(_varIdx);
+    localVarUtil.UpdateFlipHeap(_varIdx);
+  }
+
   // 更新禁忌表
   if (_delta > 0)
   {
     localVar.lastIncStep = curStep;
     localVar.allowDecStep =
-        curStep + tabuBase + mt() % tabuVariation;
+        curStep + tabuBase + rng.Bounded(tabuVariation);
   }
   else
   {
     localVar.lastDecStep = curStep;
     localVar.allowIncStep =
-        curStep + tabuBase + mt() % tabuVariation;
+        curStep + tabuBase + rng.Bounded(tabuVariation);
   }
 }
 
+void LocalMIP::RecomputeLHS()
+{
+  ++cacheEpoch;
+  for (size_t conIdx = 0; conIdx < modelConUtil->conNum; ++conIdx)
+  {
+    auto &localCon = localConUtil.conSet[conIdx];
+    auto &modelCon = modelConUtil->conSet[conIdx];
+    Value exactLHS = 0;
+    workUnits += modelCon.termNum;
+    for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+      exactLHS +=
+          modelCon.coeffSet[termIdx] *
+          localVarUtil.GetVar(modelCon.varIdxSet[termIdx]).nowValue;
+    Value drift = fabs(exactLHS - localCon.LHS);
+    if (drift > 0)
+    {
+      ++driftConNum; // 统计发生漂移的约束次数
+      if (drift > maxDrift)
+        maxDrift = drift;
+    }
+    if (conIdx == 0)
+    {
+      localCon.LHS = exactLHS;
+      continue;
+    }
+    bool isPreSat = localCon.SAT();
+    bool isNowSat = exactLHS < localCon.RHS + FeasibilityTol &&
+                    exactLHS > localCon.lowerRHS - FeasibilityTol;
+    if (isPreSat && !isNowSat)
+      localConUtil.insertUnsat(conIdx);
+    else if (!isPreSat && isNowSat)
+      localConUtil.RemoveUnsat(conIdx);
+    localCon.LHS = exactLHS;
+  }
+  if (isFlipEngine)
+    InitFlipEngine();
+}
+
 void LocalMIP::Restart()
 {
   lastImproveStep = curStep;
   ++restartTimes;
+  ++cacheEpoch;
   localConUtil.unsatConIdxs.clear(); // 清空不满足的约束
 
   // 随机重置变量值
   for (size_t varIdx = 0; varIdx < modelVarUtil->varNum; varIdx++)
   {
     auto &localVar = localVarUtil.GetVar(varIdx);
+    auto &varHistory = localVarUtil.GetHistory(varIdx);
     auto &modelVar = modelVarUtil->GetVar(varIdx);
     if (modelVar.type == VarType::Binary)
-      localVar.nowValue = mt() % 2; // 二进制变量随机赋值
+      localVar.nowValue = rng.Bounded(2); // 二进制变量随机赋值
     else if (modelVar.type == VarType::Integer &&
              modelVar.lowerBound > -1e15 &&
              modelVar.upperBound < 1e15)
     {
       long long lowerBound = (long long)modelVar.lowerBound;
       long long upperBound = (long long)modelVar.upperBound;
-      localVar.nowValue = modelVar.lowerBound + (mt() % (upperBound + 1 - lowerBound)); // 整数变量随机赋值
+      localVar.nowValue = modelVar.lowerBound + rng.Bounded(upperBound + 1 - lowerBound); // 整数变量随机赋值
     }
     else
     {
@@ -263,8 +441,8 @@ void LocalMIP::Restart()
     assert(modelVar.InBound(localVar.nowValue));
 
     // 50%概率恢复为最优解
-    if (isFoundFeasible && mt() % 100 > 50)
-      localVar.nowValue = localVar.bestValue;
+    if (isFoundFeasible && rng.Bounded(100) > 50)
+      localVar.nowValue = varHistory.bestValue;
 
     // 重置禁忌表
     localVar.lastDecStep = curStep;
@@ -279,6 +457,7 @@ void LocalMIP::Restart()
     auto &localCon = localConUtil.conSet[conIdx];
     auto &modelCon = modelConUtil->conSet[conIdx];
     localCon.LHS = 0;
+    workUnits += modelCon.termNum;
     for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
       localCon.LHS +=
           modelCon.coeffSet[termIdx] *
@@ -286,6 +465,7 @@ void LocalMIP::Restart()
     if (localCon.UNSAT())
       localConUtil.insertUnsat(conIdx);
     localCon.weight = 1; // 重置权重
+    localConUtil.lowerWeights[conIdx] = 1;
   }
 
   // 重新初始化目标函数
@@ -297,6 +477,8 @@ void LocalMIP::Restart()
     localObj.LHS +=
         modelObj.coeffSet[termIdx] *
         localVarUtil.GetVar(modelObj.varIdxSet[termIdx]).nowValue;
+  if (isFlipEngine)
+    InitFlipEngine();
 }
 
 bool LocalMIP::VerifySolution()
@@ -304,7 +486,7 @@ bool LocalMIP::VerifySolution()
   // 检查变量边界
   for (size_t var_idx = 0; var_idx < modelVarUtil->varNum; var_idx++)
   {
-    auto &var = localVarUtil.GetVar(var_idx);
+    auto &var = localVarUtil.GetHistory(var_idx);
     auto &modelVar = modelVarUtil->GetVar(var_idx);
     if (!modelVar.InBound(var.bestValue))
       return false;
@@ -319,10 +501,11 @@ bool LocalMIP::VerifySolution()
     for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
       lhs +=
           modelCon.coeffSet[termIdx] *
-          localVarUtil.GetVar(modelCon.varIdxSet[termIdx]).bestValue;
-    if (lhs > modelCon.RHS + FeasibilityTol)
+          localVarUtil.GetHistory(modelCon.varIdxSet[termIdx]).bestValue;
+    if (lhs > modelCon.RHS + FeasibilityTol ||
+        lhs < modelCon.lowerRHS - FeasibilityTol)
     {
-      printf("c lhs: %lf; rhs: %lf\n", lhs, modelCon.RHS);
+      printf("c lhs: %lf; rhs: [%lf, %lf]\n", lhs, modelCon.lowerRHS, modelCon.RHS);
       return false;
     }
   }
@@ -334,21 +517,22 @@ bool LocalMIP::VerifySolution()
   for (size_t termIdx = 0; termIdx < modelObj.termNum; ++termIdx)
     objValue +=
         modelObj.coeffSet[termIdx] *
-        localVarUtil.GetVar(modelObj.varIdxSet[termIdx]).bestValue;
+        localVarUtil.GetHistory(modelObj.varIdxSet[termIdx]).bestValue;
   return fabs(objValue - bestOBJ) < 1e-3; // 允许微小误差
 }
 
 void LocalMIP::PrintSol()
 {
+  // 预处理消去的变量由后处理栈恢复
+  vector<Value> values(modelVarUtil->varNum);
+  for (size_t varIdx = 0; varIdx < modelVarUtil->varNum; varIdx++)
+    values[varIdx] = localVarUtil.GetHistory(varIdx).bestValue;
+  modelVarUtil->postsolve.Apply(values);
   printf("c best-found solution:\n");
   printf("%-50s        %s\n", "Variable name", "Variable value");
   for (size_t varIdx = 0; varIdx < modelVarUtil->varNum; varIdx++)
-  {
-    const auto &var = localVarUtil.GetVar(varIdx);
-    const auto &modelVar = modelVarUtil->GetVar(varIdx);
-    if (var.bestValue)
-      printf("%-50s        %lf\n", modelVar.name.c_str(), var.bestValue); // 打印变量名和值
-  }
+    if (values[varIdx])
+      printf("%-50s        %lf\n", modelVarUtil->GetVar(varIdx).name.c_str(), values[varIdx]); // 打印变量名和值
 }
 
 void LocalMIP::Allocate()
@@ -375,8 +559,27 @@ void LocalMIP::Allocate()
   sampleSat = 20;
   bmsSat = 190;
   RunTime=-1;
+  searchTime = 0;
+  isIncLHS = OPT(incLHS);
+  recomputeLHSStep = OPT(recomputeLHS);
+  isIntEngine = OPT(intEngine) && modelConUtil->isIntegral;
+  driftConNum = 0;
+  maxDrift = 0;
+  isSimdScore = OPT(simdScore) && SupportAVX2();
+  simdMinTermNum = 8;
+  isScoreCache = OPT(scoreCache);
+  cacheEpoch = 1;
+  cacheHitNum = 0;
+  cacheLookupNum = 0;
+  isFlipEngine = OPT(flipEngine) && modelVarUtil->isBin;
+  heapFlipStep = 0;
+  workUnits = 0;
+  workLimit = OPT(workLimit);
+  clockCheckInterval = 1;
+  nextClockStep = 0;
   bmsFlip = 20;
-  printf("%ld\n",modelVarUtil->varNum);
+  if (portfolioSlot == 0)
+    printf("%ld\n",modelVarUtil->varNum);
   for (size_t VarIdx = 0; VarIdx < modelVarUtil->varNum; VarIdx++) {
     PickVar.push_back(0);
     VarValue.push_back(1);
@@ -389,19 +592,61 @@ void LocalMIP::Allocate()
   }
   bmsRandom = 150;
   bestOBJ = Infinity;
+  // 候选列表的容量上界：一步内采样的约束项数加目标函数项数，且不超过总项数
+  size_t maxTermNum = 0;
+  size_t totalTermNum = 0;
+  for (const auto &modelCon : modelConUtil->conSet)
+  {
+    maxTermNum = max(maxTermNum, modelCon.termNum);
+    totalTermNum += modelCon.termNum;
+  }
+  isAdaptBudget = OPT(adaptBudget);
+  budgetMinScale = OPT(budgetMinScale);
+  budgetMaxScale = OPT(budgetMaxScale);
+  budgetEpoch = OPT(budgetEpoch);
+  // 组合求解时各线程（槽位）使用不同的预算比例或调度策略
+  budgetScale = 1;
+  if (portfolioSlot % 4 == 1)
+    budgetScale = 0.5;
+  else if (portfolioSlot % 4 == 2)
+    budgetScale = 2;
+  else if (portfolioSlot % 4 == 3 && scheduler == FixedChain)
+    scheduler = EXP3;
+  size_t maxSampleCon = (size_t)ceil(
+      max(sampleUnsat, sampleSat) *
+      (isAdaptBudget ? max(budgetMaxScale, budgetScale) : budgetScale));
+  size_t neighborCapacity = min(
+      totalTermNum,
+      maxSampleCon * maxTermNum + modelConUtil->conSet[0].termNum);
   localVarUtil.Allocate(
       modelVarUtil->varNum,
-      modelConUtil->conSet[0].varIdxSet.size());
+      modelConUtil->conSet[0].termNum,
+      max(neighborCapacity, modelVarUtil->varNum));
   localConUtil.Allocate(modelConUtil->conNum);
+  if (isScoreCache)
+    localVarUtil.AllocateScoreCache(modelVarUtil->varNum);
   for (size_t conIdx = 1; conIdx < modelConUtil->conNum; conIdx++)
+  {
     localConUtil.conSet[conIdx].RHS = modelConUtil->conSet[conIdx].RHS;
+    localConUtil.conSet[conIdx].lowerRHS = modelConUtil->conSet[conIdx].lowerRHS;
+  }
   for (size_t varIdx = 0; varIdx < modelVarUtil->varNum; varIdx++)
   {
     auto &modelVar = modelVarUtil->GetVar(varIdx);
     if (modelVar.type == VarType::Binary)
       localVarUtil.binaryIdx.push_back(varIdx);
   }
-  mt.seed(2832);
+  if (isFlipEngine)
+    localVarUtil.AllocateFlipEngine(modelVarUtil->varNum);
+  rng.Seed(OPT(seed) + portfolioSlot);
+  importStagnation = OPT(importStagnation);
+  boardTightenNum = 0;
+  boardImportNum = 0;
+  if (incumbentBoard != nullptr)
+    importValues.resize(modelVarUtil->varNum);
+  InitBudget();
+  InitScheduler();
+  InitScorePool();
 }
 
 Value LocalMIP::GetObjValue()
@@ -417,8 +662,57 @@ LocalMIP::LocalMIP(
 {
   // set running parameter
   DEBUG = OPT(DEBUG);
+  stopFlag.store(false);
+  scheduler = OPT(scheduler);
+  portfolioSlot = 0;
+  incumbentBoard = nullptr;
+  isLogObj = true;
+  isBmsValue = OPT(bmsValue);
 }
 
 LocalMIP::~LocalMIP()
 {
-}
\ No newline at end of file
+}
+void LocalMIP::PollIncumbentBoard()
+{
+  auto &localObj = localConUtil.conSet[0];
+  Value boardOBJ = incumbentBoard->BestOBJ();
+  if (boardOBJ - OptimalTol < localObj.RHS)
+  {
+    localObj.RHS = boardOBJ - OptimalTol;
+    ++boardTightenNum;
+  }
+  if (importStagnation > 0 &&
+      curStep - lastImproveStep > importStagnation &&
+      boardOBJ < bestOBJ - OptimalTol)
+    ImportIncumbent();
+}
+
+// 以共享最优解替换当前解，并重建约束状态；约束权重保持不变
+void LocalMIP::ImportIncumbent()
+{
+  Value importOBJ;
+  if (!incumbentBoard->Read(importValues, importOBJ))
+    return;
+  ++boardImportNum;
+  lastImproveStep = curStep;
+  ++cacheEpoch;
+  for (size_t varIdx = 0; varIdx < modelVarUtil->varNum; varIdx++)
+    localVarUtil.GetVar(varIdx).nowValue = importValues[varIdx];
+  localConUtil.unsatConIdxs.clear();
+  for (size_t conIdx = 0; conIdx < modelConUtil->conNum; ++conIdx)
+  {
+    auto &localCon = localConUtil.conSet[conIdx];
+    auto &modelCon = modelConUtil->conSet[conIdx];
+    localCon.LHS = 0;
+    workUnits += modelCon.termNum;
+    for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+      localCon.LHS +=
+          modelCon.coeffSet[termIdx] *
+          localVarUtil.GetVar(modelCon.varIdxSet[termIdx]).nowValue;
+    if (conIdx > 0 && localCon.UNSAT())
+      localConUtil.insertUnsat(conIdx);
+  }
+  if (isFlipEngine)
+    InitFlipEngine();
+}
@@ -16,10 +16,42 @@
 
 #pragma once
 #include "utils/paras.h"
+#include "utils/Random.h"
 #include "ModelCon.h"
 #include "ModelVar.h"
 #include "LocalCon.h"
 #include "LocalVar.h"
+#include "IncumbentBoard.h"
+#include "ScorePool.h"
+
+// 调度器可选择的邻域算子
+enum OperatorArm
+{
+  ArmUnsatTight,
+  ArmSatTight,
+  ArmFlip,
+  ArmRandomTight,
+  ArmLift,
+  OperatorNum
+};
+
+// 算子调度策略
+enum SchedulerType
+{
+  FixedChain,
+  UCB1,
+  Thompson,
+  EXP3
+};
+
+// 并行评分时每个线程的局部最优，按缓存行对齐避免伪共享
+struct alignas(64) ScoreChunkResult
+{
+  long score;
+  long subscore;
+  size_t pos;
+  size_t workUnits;
+};
 
 class LocalMIP
 {
@@ -29,7 +61,7 @@ private:
   LocalVarUtil localVarUtil;
   LocalConUtil localConUtil;
   size_t curStep;
-  std::mt19937 mt;
+  Random rng;
   size_t smoothProbability;
   size_t tabuBase;
   size_t tabuVariation;
@@ -60,8 +92,75 @@ private:
   vector<vector<double>> reward;
   vector<size_t> Varindex;
   double RunTime;
+  double searchTime;
   bool DEBUG;
+  bool isIncLHS;
+  size_t recomputeLHSStep;
+  bool isIntEngine;
+  size_t driftConNum;
+  Value maxDrift;
+  bool isSimdScore;
+  size_t simdMinTermNum;
+  bool isScoreCache;
+  size_t cacheEpoch;
+  size_t cacheHitNum;
+  size_t cacheLookupNum;
+  bool isFlipEngine;
+  size_t heapFlipStep;
+  size_t workUnits;
+  size_t workLimit;
+  size_t clockCheckInterval;
+  size_t nextClockStep;
+  chrono::_V2::system_clock::time_point lastClockCheck;
+  std::atomic<bool> stopFlag;
+  size_t scheduler;
+  bool isBmsValue;
+  size_t portfolioSlot;
+  IncumbentBoard *incumbentBoard;
+  bool isLogObj;
+  size_t importStagnation;
+  size_t boardTightenNum;
+  size_t boardImportNum;
+  vector<Value> importValues;
+  bool isAdaptBudget;
+  double budgetScale;
+  double budgetMinScale;
+  double budgetMaxScale;
+  double budgetDirection;
+  size_t budgetEpoch;
+  size_t nextBudgetStep;
+  size_t baseSampleUnsat;
+  size_t baseBmsUnsatInfeas;
+  size_t baseBmsUnsatFeas;
+  size_t baseSampleSat;
+  size_t baseBmsSat;
+  size_t baseBmsFlip;
+  size_t baseBmsRandom;
+  size_t epochStartStep;
+  size_t epochStartUnsatNum;
+  size_t bestUnsatNum;
+  Value epochStartBestOBJ;
+  double lastEpochGainRate;
+  double lastEpochStepRate;
+  chrono::_V2::system_clock::time_point epochStartTime;
+  size_t armPullNum[OperatorNum];
+  size_t armMoveNum[OperatorNum];
+  double armRewardSum[OperatorNum];
+  size_t armWork[OperatorNum];
+  double armAlpha[OperatorNum];
+  double armBeta[OperatorNum];
+  double armWeight[OperatorNum];
+  double armProb[OperatorNum];
+  double meanRewardRate;
+  double exp3Gamma;
+  size_t exp3AvailableNum;
   long subscore;
+  ScorePool scorePool;
+  size_t scoreThreadNum;
+  size_t parallelMinNeighbor;
+  size_t parallelScoreSize;
+  size_t parallelScoreNum;
+  vector<ScoreChunkResult> chunkResults;
   bool VerifySolution();
   void InitState();
   void UpdateBestSolution();
@@ -70,12 +169,56 @@ private:
   bool FlipMove(
       vector<bool> &_scoreTable,
       vector<size_t> &_scoreIdx);
-  void RandomTightMove();
+  bool RandomTightMove();
+  void SampleNeighborByValue(
+      size_t _sampleNum);
+  void UpdateVarValue(
+      size_t _varIdx,
+      Value _preOBJ);
   void LiftMove();
   bool LiftMoveWithoutBreak();
+  void LiftRange(
+      const ModelVar &_modelVar,
+      Value &_lowerDelta,
+      Value &_upperDelta);
+  void InitScheduler();
+  bool IsArmAvailable(
+      size_t _arm);
+  size_t SelectOperator();
+  bool RunOperator(
+      size_t _arm);
+  void UpdateOperator(
+      size_t _arm,
+      double _reward);
+  void ScheduledStep();
+  void PrintOperatorStats();
+  void InitBudget();
+  void ApplyBudgetScale();
+  void AdaptBudget();
+  void PollIncumbentBoard();
+  void ImportIncumbent();
   bool SatTightMove(
       vector<bool> &_scoreTable,
       vector<size_t> &_scoreIdx);
+  void InvalidateScoreCache(
+      size_t _conIdx);
+  void InitFlipEngine();
+  void RescoreFlipVar(
+      size_t _varIdx);
+  long FlipObjScore(
+      const ModelVar &_modelVar,
+      size_t _objWeight);
+  void FlipEngineRowChange(
+      size_t _conIdx,
+      Value _oldLHS,
+      Value _newLHS,
+      size_t _movedVarIdx);
+  void FlipEngineWeightChange(
+      size_t _conIdx,
+      size_t _oldWeight,
+      size_t _oldLowerWeight);
+  void FlipEngineObjWeightChange(
+      size_t _oldWeight);
   void UpdateWeight();
   void SmoothWeight();
   void ApplyMove(
@@ -84,12 +227,67 @@ private:
   long TightScore(
       const ModelVar &_var,
       Value _delta);
+  long TightScoreShared(
+      const ModelVar &_var,
+      Value _delta,
+      long &_subscore);
+  template <bool isObjVar, bool isShared>
+  long TightScoreImpl(
+      const ModelVar &_var,
+      Value _delta,
+      long &_subscore);
+  long TightScoreAVX2(
+      const ModelVar &_var,
+      size_t _termBegin,
+      Value _delta,
+      long &_subscore);
+  void InitScorePool();
+  bool IsParallelScore(
+      size_t _scoreSize);
+  size_t SkipScoredBinary(
+      size_t _scoreSize,
+      vector<bool> &_scoreTable,
+      vector<size_t> &_scoreIdxs);
+  void ParallelScore(
+      size_t _scoreSize,
+      long &_bestScore,
+      long &_bestSubscore,
+      size_t &_bestVarIdx,
+      Value &_bestDelta);
+  static void ScoreChunkTask(
+      void *_localMIP,
+      size_t _chunkIdx);
+  void ScoreChunk(
+      size_t _chunkIdx);
+  static bool SupportAVX2();
   bool TightDelta(
       LocalCon &_con,
       const ModelCon &_modelCon,
       size_t _i,
       Value &_res);
+  bool TightDelta(
+      LocalCon &_con,
+      const ModelCon &_modelCon,
+      size_t _i,
+      bool _isLowerSide,
+      Value &_res);
+  template <bool isReal>
+  bool TightDeltaImpl(
+      const LocalCon &_con,
+      const ModelCon &_modelCon,
+      const ModelVar &_modelVar,
+      size_t _i,
+      bool _isLowerSide,
+      Value &_res);
+  bool TightDeltaExact(
+      const LocalCon &_con,
+      const ModelCon &_modelCon,
+      const ModelVar &_modelVar,
+      size_t _i,
+      bool _isLowerSide,
+      Value &_res);
   void InitSolution();
+  void RecomputeLHS();
   bool Timeout(
       chrono::_V2::system_clock::time_point &_clkStart);
   void LogObj(
@@ -104,7 +302,23 @@ public:
       Value _optimalObj,
       chrono::_V2::system_clock::time_point _clkStart);
   void PrintResult();
+  void Stop();
+  void SetPortfolioSlot(
+      size_t _slot);
+  void SetIncumbentBoard(
+      IncumbentBoard *_incumbentBoard);
+  void SetLogObj(
+      bool _isLogObj);
+  bool IsFoundFeasible();
+  Value GetBestOBJ();
+  size_t GetStepNum();
   void PrintSol();
   void Allocate();
   Value GetObjValue();
-};
\ No newline at end of file
+};
+
+void save_result(
+    const char *_filename,
+    int _win,
+    double _time,
+    double _bestobj);
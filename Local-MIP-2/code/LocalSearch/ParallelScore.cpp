@@ -0,0 +1,122 @@
+/*=====================================================================================
+
+    Filename:     ParallelScore.cpp
+
+    Description:  Chunked scoring of one large neighbourhood on the score pool
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "LocalMIP.h"
+
+void LocalMIP::InitScorePool()
+{
+  scoreThreadNum = OPT(scoreThreads);
+  parallelMinNeighbor = OPT(scoreParallelMin);
+  parallelScoreSize = 0;
+  parallelScoreNum = 0;
+  chunkResults.resize(scoreThreadNum);
+  if (scoreThreadNum > 1)
+    scorePool.Start(scoreThreadNum - 1);
+}
+
+bool LocalMIP::IsParallelScore(
+    size_t _scoreSize)
+{
+  return scoreThreadNum > 1 && _scoreSize >= parallelMinNeighbor;
+}
+
+// 与串行循环一致地跳过本步已评分的二进制变量，把剩余候选按原顺序压缩到前部
+size_t LocalMIP::SkipScoredBinary(
+    size_t _scoreSize,
+    vector<bool> &_scoreTable,
+    vector<size_t> &_scoreIdxs)
+{
+  vector<size_t> &neighborVarIdxs = localVarUtil.tempVarIdxs;
+  vector<Value> &neighborDeltas = localVarUtil.tempDeltas;
+  size_t keepNum = 0;
+  for (size_t idx = 0; idx < _scoreSize; ++idx)
+  {
+    size_t varIdx = neighborVarIdxs[idx];
+    if (modelVarUtil->GetVar(varIdx).type == VarType::Binary)
+    {
+      if (_scoreTable[varIdx])
+        continue;
+      _scoreTable[varIdx] = true;
+      _scoreIdxs.push_back(varIdx);
+    }
+    neighborVarIdxs[keepNum] = varIdx;
+    neighborDeltas[keepNum] = neighborDeltas[idx];
+    ++keepNum;
+  }
+  return keepNum;
+}
+
+// 候选 [0, _scoreSize) 按线程切成连续块，各块在本块内取最优（同分取靠前者），
+// 再按块顺序用与串行循环相同的严格比较归并，因此结果与串行评分逐位一致
+void LocalMIP::ParallelScore(
+    size_t _scoreSize,
+    long &_bestScore,
+    long &_bestSubscore,
+    size_t &_bestVarIdx,
+    Value &_bestDelta)
+{
+  parallelScoreSize = _scoreSize;
+  ++parallelScoreNum;
+  scorePool.Run(ScoreChunkTask, this);
+  for (size_t chunkIdx = 0; chunkIdx < scoreThreadNum; ++chunkIdx)
+  {
+    const auto &result = chunkResults[chunkIdx];
+    workUnits += result.workUnits;
+    if (result.pos == _scoreSize)
+      continue;
+    if (_bestScore < result.score ||
+        (_bestScore == result.score && _bestSubscore < result.subscore))
+    {
+      _bestScore = result.score;
+      _bestSubscore = result.subscore;
+      _bestVarIdx = localVarUtil.tempVarIdxs[result.pos];
+      _bestDelta = localVarUtil.tempDeltas[result.pos];
+    }
+  }
+}
+
+void LocalMIP::ScoreChunkTask(
+    void *_localMIP,
+    size_t _chunkIdx)
+{
+  static_cast<LocalMIP *>(_localMIP)->ScoreChunk(_chunkIdx);
+}
+
+// 只读取约束状态，结果写入本线程独占的 chunkResults[_chunkIdx]
+void LocalMIP::ScoreChunk(
+    size_t _chunkIdx)
+{
+  size_t begin = parallelScoreSize * _chunkIdx / scoreThreadNum;
+  size_t end = parallelScoreSize * (_chunkIdx + 1) / scoreThreadNum;
+  auto &result = chunkResults[_chunkIdx];
+  result.pos = parallelScoreSize;
+  result.workUnits = 0;
+  for (size_t idx = begin; idx < end; ++idx)
+  {
+    const auto &modelVar = modelVarUtil->GetVar(localVarUtil.tempVarIdxs[idx]);
+    long chunkSubscore;
+    long score = TightScoreShared(modelVar, localVarUtil.tempDeltas[idx], chunkSubscore);
+    result.workUnits += modelVar.termNum;
+    if (result.pos == parallelScoreSize ||
+        result.score < score ||
+        (result.score == score && result.subscore < chunkSubscore))
+    {
+      result.score = score;
+      result.subscore = chunkSubscore;
+      result.pos = idx;
+    }
+  }
+}
@@ -2,7 +2,7 @@
 
 #include "LocalMIP.h"
 
-void LocalMIP::RandomTightMove()
+bool LocalMIP::RandomTightMove()
 {
   // 初始化变量以跟踪最佳移动
   long bestScore = -100000000000; // 最佳得分（初始化为极小值）
@@ -20,7 +20,7 @@ void LocalMIP::RandomTightMove()
   if (localConUtil.unsatConIdxs.size() > 0) // 存在未满足的约束时
   {
     // 随机选择一个不满足的约束（避免固定顺序导致的局部最优）
-    size_t conIdx = localConUtil.unsatConIdxs[mt() % localConUtil.unsatConIdxs.size()];
+    size_t conIdx = localConUtil.unsatConIdxs[rng.Bounded(localConUtil.unsatConIdxs.size())];
     auto &localCon = localConUtil.conSet[conIdx];   // 本地约束状态
     auto &modelCon = modelConUtil->conSet[conIdx]; // 模型约束定义
 
@@ -35,11 +35,11 @@ void LocalMIP::RandomTightMove()
       Value delta;
       if (!TightDelta(localCon, modelCon, termIdx, delta)) // 若TightDelta计算失败（可能边界已紧）
       {
-        // 备用方案：将delta设置为变量边界值（根据系数符号选择上下界）
-        if (modelCon.coeffSet[termIdx] > 0)
-          delta = modelVar.lowerBound - localVar.nowValue; // 正系数时向下收紧
+        // 备用方案：将delta设置为变量边界值（根据系数符号与违反的一侧选择上下界）
+        if ((modelCon.coeffSet[termIdx] > 0) != localCon.BelowLower())
+          delta = modelVar.lowerBound - localVar.nowValue; // 变量移到下界
         else
-          delta = modelVar.upperBound - localVar.nowValue; // 负系数时向上收紧
+          delta = modelVar.upperBound - localVar.nowValue; // 变量移到上界
       }
 
       // 过滤无效移动：
@@ -93,10 +93,13 @@ void LocalMIP::RandomTightMove()
   if (neighborVarIdxs.size() > bmsRandom) // 候选数超过设定阈值时
   {
     scoreSize = bmsRandom; // 仅保留前bmsRandom个候选
-    if (!isFoundFeasible) {
+    if (isBmsValue) {
+      SampleNeighborByValue(scoreSize); // 按变量价值加权抽样，O(log n) 每次
+    }
+    else if (!isFoundFeasible) {
       for (size_t bmsIdx = 0; bmsIdx < bmsRandom; ++bmsIdx) {
         // 随机选择候选
-        size_t randomIdx = (mt() % (neighborVarIdxs.size() - bmsIdx)) + bmsIdx;
+        size_t randomIdx = rng.Bounded(neighborVarIdxs.size() - bmsIdx) + bmsIdx;
         // 交换当前位置与随机位置的候选
         size_t varIdx = neighborVarIdxs[randomIdx];
         Value delta = neighborDeltas[randomIdx];
@@ -127,25 +130,28 @@ void LocalMIP::RandomTightMove()
   }
 
   // 第四部分：评估候选变量并选择最佳移动（基于得分函数）
-  for (size_t idx = 0; idx < scoreSize; ++idx)
-  {
-    size_t varIdx = neighborVarIdxs[idx];
-    Value delta = neighborDeltas[idx];
-    auto &localVar = localVarUtil.GetVar(varIdx);
-    auto &modelVar = modelVarUtil->GetVar(varIdx);
-
-    // 计算移动的得分
-    long score = TightScore(modelVar, delta);
-    // 更新最佳移动
-    if (bestScore < score ||
-        bestScore == score && bestSubscore < subscore)
+  if (IsParallelScore(scoreSize))
+    ParallelScore(scoreSize, bestScore, bestSubscore, bestVarIdx, bestDelta);
+  else
+    for (size_t idx = 0; idx < scoreSize; ++idx)
     {
-      bestScore = score;
-      bestVarIdx = varIdx;
-      bestDelta = delta;
-      bestSubscore = subscore;
+      size_t varIdx = neighborVarIdxs[idx];
+      Value delta = neighborDeltas[idx];
+      auto &localVar = localVarUtil.GetVar(varIdx);
+      auto &modelVar = modelVarUtil->GetVar(varIdx);
+
+      // 计算移动的得分
+      long score = TightScore(modelVar, delta);
+      // 更新最佳移动
+      if (bestScore < score ||
+          bestScore == score && bestSubscore < subscore)
+      {
+        bestScore = score;
+        bestVarIdx = varIdx;
+        bestDelta = delta;
+        bestSubscore = subscore;
+      }
     }
-  }
   // bestVarIdx%=reward.size();
   // 第五部分：应用最佳移动（如果找到有效移动）
   if (bestVarIdx != -1 && bestDelta != 0)
@@ -156,17 +162,9 @@ void LocalMIP::RandomTightMove()
     ApplyMove(bestVarIdx, bestDelta); // 执行变量调整
     PickVar[bestVarIdx]++;
     ++randomStep; // 随机移动步骤计数
-    if (isFoundFeasible) {
-      reward[bestVarIdx][Varindex[bestVarIdx]]=((lastValue-localConUtil.conSet[0].LHS)/(lastValue-bestOBJ+1));
-      double gamma=pow(0.89,4);
-      // VarValue[bestVarIdx]*=(1-1/PickVar[bestVarIdx]);
-      // printf("%ld\n",PickVar[bestVarIdx]);
-      for (size_t idx = 1; idx <= 5; ++idx) {
-        VarValue[bestVarIdx]+=(gamma*reward[bestVarIdx][(idx+Varindex[bestVarIdx])%5]);
-        gamma/=0.89;
-      }
-      Varindex[bestVarIdx]=(++Varindex[bestVarIdx])%5;
-    }
-    return;
+    if (isFoundFeasible)
+      UpdateVarValue(bestVarIdx, lastValue);
+    return true;
   }
+  return false;
 }
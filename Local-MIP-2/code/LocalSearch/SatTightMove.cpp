@@ -39,17 +39,17 @@ bool LocalMIP::SatTightMove(
   // 使用临时向量存储满足约束的索引
   auto &neighborConIdxs = localConUtil.tempSatConIdxs;
   neighborConIdxs.clear();
-  localConUtil.sampleSet.clear(); // 清空采样集合
+  ++localConUtil.sampleEpoch; // 递增时间戳，相当于清空采样标记
 
   // 第一部分：随机采样满足的约束
   for (size_t time = 0; time < sampleSat; time++)
   {
-    size_t conIdx = mt() % (modelConUtil->conNum - 1) + 1; // 随机选择一个约束（跳过目标函数）
-    if (localConUtil.sampleSet.find(conIdx) == localConUtil.sampleSet.end() && // 避免重复采样
+    size_t conIdx = rng.Bounded(modelConUtil->conNum - 1) + 1; // 随机选择一个约束（跳过目标函数）
+    if (localConUtil.sampleStamp[conIdx] != localConUtil.sampleEpoch && // 避免重复采样
         localConUtil.conSet[conIdx].SAT() && // 约束必须满足
         !modelConUtil->conSet[conIdx].inferSAT) // 约束不能是推断满足的
     {
-      localConUtil.sampleSet.insert(conIdx); // 记录已采样的约束
+      localConUtil.sampleStamp[conIdx] = localConUtil.sampleEpoch; // 记录已采样的约束
       neighborConIdxs.push_back(conIdx); // 添加到候选约束列表
     }
   }
@@ -61,20 +61,25 @@ bool LocalMIP::SatTightMove(
     auto &localCon = localConUtil.conSet[neighborConIdxs[neighborIdx]];
     auto &modelCon = modelConUtil->conSet[neighborConIdxs[neighborIdx]];
 
-    // 遍历约束中的每一项
-    for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+    // 遍历约束中的每一项；区间与等式约束两侧都生成候选，下界一侧使 LHS 降向 lowerRHS
+    size_t sideNum = localCon.lowerRHS != NegativeInfinity ? 2 : 1;
+    for (size_t sideIdx = 0; sideIdx < sideNum * modelCon.termNum; ++sideIdx)
     {
+      bool isLowerSide = sideIdx >= modelCon.termNum;
+      size_t termIdx = isLowerSide ? sideIdx - modelCon.termNum : sideIdx;
       size_t varIdx = modelCon.varIdxSet[termIdx];
       auto &localVar = localVarUtil.GetVar(varIdx);
       auto &modelVar = modelVarUtil->GetVar(varIdx);
 
       // 计算使约束更紧的变化值 delta
       Value delta;
-      if (!TightDelta(localCon, modelCon, termIdx, delta))
-        if (modelCon.coeffSet[termIdx] > 0)
+      if (!TightDelta(localCon, modelCon, termIdx, isLowerSide, delta))
+      {
+        if ((modelCon.coeffSet[termIdx] > 0) != isLowerSide)
           delta = modelVar.upperBound - localVar.nowValue;
         else
           delta = modelVar.lowerBound - localVar.nowValue;
+      }
 
       // 跳过以下情况：
       // 1. 移动违反禁忌条件（允许变化的步数）
@@ -96,50 +101,59 @@ bool LocalMIP::SatTightMove(
   if (neighborVarIdxs.size() > bmsSat)
   {
     scoreSize = bmsSat;
-    for (size_t bmsIdx = 0; bmsIdx < bmsSat; ++bmsIdx)
-    {
-      size_t randomIdx = (mt() % (neighborVarIdxs.size() - bmsIdx)) + bmsIdx;
-      // 将随机选择的候选交换到前面
-      size_t varIdx = neighborVarIdxs[randomIdx];
-      Value delta = neighborDeltas[randomIdx];
-      neighborVarIdxs[randomIdx] = neighborVarIdxs[bmsIdx];
-      neighborDeltas[randomIdx] = neighborDeltas[bmsIdx];
-      neighborVarIdxs[bmsIdx] = varIdx;
-      neighborDeltas[bmsIdx] = delta;
-    }
+    if (isBmsValue)
+      SampleNeighborByValue(scoreSize); // 按变量价值加权抽样
+    else
+      for (size_t bmsIdx = 0; bmsIdx < bmsSat; ++bmsIdx)
+      {
+        size_t randomIdx = rng.Bounded(neighborVarIdxs.size() - bmsIdx) + bmsIdx;
+        // 将随机选择的候选交换到前面
+        size_t varIdx = neighborVarIdxs[randomIdx];
+        Value delta = neighborDeltas[randomIdx];
+        neighborVarIdxs[randomIdx] = neighborVarIdxs[bmsIdx];
+        neighborDeltas[randomIdx] = neighborDeltas[bmsIdx];
+        neighborVarIdxs[bmsIdx] = varIdx;
+        neighborDeltas[bmsIdx] = delta;
+      }
   }
 
   // 第四部分：评估候选变量并选择最佳移动
-  for (size_t idx = 0; idx < scoreSize; ++idx)
+  if (IsParallelScore(scoreSize))
   {
-    size_t varIdx = neighborVarIdxs[idx];
-    Value delta = neighborDeltas[idx];
-    auto &localVar = localVarUtil.GetVar(varIdx);
-    auto &modelVar = modelVarUtil->GetVar(varIdx);
-
-    // 处理二进制变量：避免重复评分
-    if (modelVar.type == VarType::Binary)
+    scoreSize = SkipScoredBinary(scoreSize, score_table, score_idx);
+    ParallelScore(scoreSize, bestScore, bestSubscore, bestVarIdx, bestDelta);
+  }
+  else
+    for (size_t idx = 0; idx < scoreSize; ++idx)
     {
-      if (score_table[varIdx])
-        continue; // 已评分，跳过
-      else
+      size_t varIdx = neighborVarIdxs[idx];
+      Value delta = neighborDeltas[idx];
+      auto &localVar = localVarUtil.GetVar(varIdx);
+      auto &modelVar = modelVarUtil->GetVar(varIdx);
+
+      // 处理二进制变量：避免重复评分
+      if (modelVar.type == VarType::Binary)
       {
-        score_table[varIdx] = true; // 标记为已评分
-        score_idx.push_back(varIdx); // 记录评分变量的索引
+        if (score_table[varIdx])
+          continue; // 已评分，跳过
+        else
+        {
+          score_table[varIdx] = true; // 标记为已评分
+          score_idx.push_back(varIdx); // 记录评分变量的索引
+        }
       }
-    }
 
-    // 计算移动的得分
-    long score = TightScore(modelVar, delta);
-    if (bestScore < score ||
-        bestScore == score && bestSubscore < subscore)
-    {
-      bestScore = score;
-      bestVarIdx = varIdx;
-      bestDelta = delta;
-      bestSubscore = subscore;
+      // 计算移动的得分
+      long score = TightScore(modelVar, delta);
+      if (bestScore < score ||
+          bestScore == score && bestSubscore < subscore)
+      {
+        bestScore = score;
+        bestVarIdx = varIdx;
+        bestDelta = delta;
+        bestSubscore = subscore;
+      }
     }
-  }
 
   // 第五部分：应用最佳移动（如果找到）
   if (bestScore > 0)
@@ -147,7 +161,10 @@ bool LocalMIP::SatTightMove(
     if (DEBUG)
       printf("SAT: %-12ld; ", bestScore);
     ++tightStepSat; // 更新统计信息
+    Value preOBJ = localConUtil.conSet[0].LHS;
     ApplyMove(bestVarIdx, bestDelta); // 应用移动
+    if (isBmsValue && isFoundFeasible)
+      UpdateVarValue(bestVarIdx, preOBJ);
     PickVar[bestVarIdx]++;
     return true;
   }
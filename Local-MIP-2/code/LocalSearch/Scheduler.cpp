@@ -0,0 +1,239 @@
+/*=====================================================================================
+
+    Filename:     Scheduler.cpp
+
+    Description:  Multi-armed bandit scheduling of the neighbourhood operators
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "LocalMIP.h"
+
+static const char *armName[OperatorNum] = {
+    "UnsatTight", "SatTight", "Flip", "RandomTight", "Lift"};
+
+void LocalMIP::InitScheduler()
+{
+  for (size_t arm = 0; arm < OperatorNum; ++arm)
+  {
+    armPullNum[arm] = 0;
+    armMoveNum[arm] = 0;
+    armRewardSum[arm] = 0;
+    armWork[arm] = 0;
+    armAlpha[arm] = 1;
+    armBeta[arm] = 1;
+    armWeight[arm] = 1;
+    armProb[arm] = 0;
+  }
+  meanRewardRate = 0;
+  exp3Gamma = 0.1;
+  exp3AvailableNum = 0;
+}
+
+// 算子在当前状态下是否有意义：提升移动要求当前解可行，满足约束的移动沿用原逻辑只在找到可行解后使用
+bool LocalMIP::IsArmAvailable(
+    size_t _arm)
+{
+  switch (_arm)
+  {
+  case ArmSatTight:
+    return isFoundFeasible && modelConUtil->conNum > 1;
+  case ArmFlip:
+    return !localVarUtil.binaryIdx.empty();
+  case ArmLift:
+    return localConUtil.unsatConIdxs.empty();
+  default:
+    return true;
+  }
+}
+
+size_t LocalMIP::SelectOperator()
+{
+  size_t bestArm = ArmUnsatTight;
+  double bestValue = -1;
+  if (scheduler == UCB1)
+  {
+    // 未尝试过的算子优先，其余取 均值 + sqrt(2 ln N / n) 最大者
+    size_t totalPullNum = 0;
+    for (size_t arm = 0; arm < OperatorNum; ++arm)
+      totalPullNum += armPullNum[arm];
+    for (size_t arm = 0; arm < OperatorNum; ++arm)
+    {
+      if (!IsArmAvailable(arm))
+        continue;
+      if (armPullNum[arm] == 0)
+        return arm;
+      double value = armRewardSum[arm] / armPullNum[arm] +
+                     sqrt(2 * log((double)totalPullNum) / armPullNum[arm]);
+      if (value > bestValue)
+      {
+        bestValue = value;
+        bestArm = arm;
+      }
+    }
+  }
+  else if (scheduler == Thompson)
+  {
+    // 从每个算子的 Beta(alpha, beta) 后验中采样，取最大者
+    for (size_t arm = 0; arm < OperatorNum; ++arm)
+    {
+      if (!IsArmAvailable(arm))
+        continue;
+      std::gamma_distribution<double> alphaGamma(armAlpha[arm], 1.0);
+      std::gamma_distribution<double> betaGamma(armBeta[arm], 1.0);
+      double x = alphaGamma(rng);
+      double y = betaGamma(rng);
+      double value = x / (x + y);
+      if (value > bestValue)
+      {
+        bestValue = value;
+        bestArm = arm;
+      }
+    }
+  }
+  else
+  {
+    // EXP3：按权重与均匀分布的混合概率抽样；完整的概率向量与可用算子数留给 UpdateOperator
+    double weightSum = 0;
+    exp3AvailableNum = 0;
+    for (size_t arm = 0; arm < OperatorNum; ++arm)
+      if (IsArmAvailable(arm))
+      {
+        weightSum += armWeight[arm];
+        ++exp3AvailableNum;
+      }
+    for (size_t arm = 0; arm < OperatorNum; ++arm)
+      armProb[arm] = IsArmAvailable(arm)
+                         ? (1 - exp3Gamma) * armWeight[arm] / weightSum +
+                               exp3Gamma / exp3AvailableNum
+                         : 0;
+    double draw = rng.Uniform();
+    for (size_t arm = 0; arm < OperatorNum; ++arm)
+    {
+      if (armProb[arm] == 0)
+        continue;
+      bestArm = arm;
+      if (draw < armProb[arm])
+        break;
+      draw -= armProb[arm];
+    }
+  }
+  return bestArm;
+}
+
+// 执行单个算子，不做级联回退；返回是否实际移动了变量
+bool LocalMIP::RunOperator(
+    size_t _arm)
+{
+  vector<bool> &scoreTable = localVarUtil.scoreTable;
+  vector<size_t> &scoreIdxs = localVarUtil.scoreIdxs;
+  bool isMoved = false;
+  switch (_arm)
+  {
+  case ArmUnsatTight:
+    return UnsatTightMove();
+  case ArmRandomTight:
+    return RandomTightMove();
+  case ArmLift:
+    return LiftMoveWithoutBreak();
+  case ArmSatTight:
+    scoreIdxs.clear();
+    isMoved = SatTightMove(scoreTable, scoreIdxs);
+    break;
+  case ArmFlip:
+    scoreIdxs.clear();
+    isMoved = FlipMove(scoreTable, scoreIdxs);
+    break;
+  }
+  for (auto idx : scoreIdxs)
+    scoreTable[idx] = false;
+  return isMoved;
+}
+
+// _reward 已归一化到 [0, 1)
+void LocalMIP::UpdateOperator(
+    size_t _arm,
+    double _reward)
+{
+  ++armPullNum[_arm];
+  armRewardSum[_arm] += _reward;
+  if (scheduler == Thompson)
+  {
+    // 以 _reward 为成功概率做一次伯努利试验
+    if (rng.Uniform() < _reward)
+      armAlpha[_arm] += 1;
+    else
+      armBeta[_arm] += 1;
+  }
+  else if (scheduler == EXP3)
+  {
+    armWeight[_arm] *= exp(exp3Gamma * _reward / armProb[_arm] / exp3AvailableNum);
+    // 权重整体缩放，避免溢出
+    double maxWeight = 0;
+    for (size_t arm = 0; arm < OperatorNum; ++arm)
+      maxWeight = max(maxWeight, armWeight[arm]);
+    if (maxWeight > 1e100)
+      for (size_t arm = 0; arm < OperatorNum; ++arm)
+        armWeight[arm] = max(armWeight[arm] / maxWeight, 1e-300);
+  }
+}
+
+// 选择并执行一个算子；失败时与固定链一样更新权重并做随机紧致移动。
+// 收益为单位工作量（系数访问次数）内不满足约束数的减少量（已可行时加上目标的相对改进），
+// 再按滑动平均收益率归一化：r / (r + 平均值)；不读时钟，相同种子与 workLimit 下可复现
+void LocalMIP::ScheduledStep()
+{
+  auto &localObj = localConUtil.conSet[0];
+  size_t arm = SelectOperator();
+  size_t preUnsatNum = localConUtil.unsatConIdxs.size();
+  Value preOBJ = localObj.LHS;
+  size_t preWorkUnits = workUnits;
+  bool isMoved = RunOperator(arm);
+  size_t cost = max(workUnits - preWorkUnits, (size_t)1);
+  armWork[arm] += cost;
+
+  double gain = 0;
+  if (isMoved)
+  {
+    ++armMoveNum[arm];
+    gain = (double)preUnsatNum - (double)localConUtil.unsatConIdxs.size();
+    if (isFoundFeasible && localConUtil.unsatConIdxs.empty())
+      gain += (preOBJ - localObj.LHS) / (fabs(preOBJ - bestOBJ) + 1);
+  }
+  double rate = max(gain, 0.0) / cost;
+  double reward;
+  if (rate <= 0)
+    reward = 0;
+  else if (meanRewardRate <= 0)
+    reward = 1 - 1e-9;
+  else
+    reward = rate / (rate + meanRewardRate);
+  if (rate > 0)
+    meanRewardRate = meanRewardRate <= 0 ? rate : 0.99 * meanRewardRate + 0.01 * rate;
+  UpdateOperator(arm, reward);
+
+  if (!isMoved)
+  {
+    if (rng.Bounded(10000) > smoothProbability)
+      UpdateWeight();
+    else
+      SmoothWeight();
+    RandomTightMove();
+  }
+}
+
+void LocalMIP::PrintOperatorStats()
+{
+  for (size_t arm = 0; arm < OperatorNum; ++arm)
+    printf("c arm %-12s pulls: %-10ld moves: %-10ld mean reward: %.4lf work units: %ld\n",
+           armName[arm], armPullNum[arm], armMoveNum[arm],
+           armPullNum[arm] > 0 ? armRewardSum[arm] / armPullNum[arm] : 0.0,
+           armWork[arm]);
+}
@@ -0,0 +1,111 @@
+/*=====================================================================================
+
+    Filename:     ScorePool.h
+
+    Description:  Persistent worker pool for scoring one neighbourhood in chunks
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#pragma once
+#include "utils/paras.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// 工作线程在搜索开始前创建并一直保留，每步只做一次唤醒与一次汇合，不产生内存分配。
+// 第 0 块由调用线程自己执行，第 k 块由第 k - 1 个工作线程执行
+class ScorePool
+{
+private:
+  vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wakeCond;
+  std::condition_variable doneCond;
+  size_t generation;
+  size_t pendingNum;
+  bool isStopping;
+  void (*task)(void *, size_t);
+  void *context;
+
+  void WorkerLoop(
+      size_t _chunkIdx)
+  {
+    size_t seenGeneration = 0;
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeCond.wait(lock, [&]
+                      { return isStopping || generation != seenGeneration; });
+        if (isStopping)
+          return;
+        seenGeneration = generation;
+      }
+      task(context, _chunkIdx);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--pendingNum == 0)
+        doneCond.notify_one();
+    }
+  }
+
+public:
+  ScorePool()
+      : generation(0),
+        pendingNum(0),
+        isStopping(false),
+        task(nullptr),
+        context(nullptr)
+  {
+  }
+
+  ~ScorePool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      isStopping = true;
+    }
+    wakeCond.notify_all();
+    for (auto &worker : workers)
+      worker.join();
+  }
+
+  void Start(
+      size_t _workerNum)
+  {
+    workers.reserve(_workerNum);
+    for (size_t workerIdx = 0; workerIdx < _workerNum; ++workerIdx)
+      workers.emplace_back(&ScorePool::WorkerLoop, this, workerIdx + 1);
+  }
+
+  size_t ThreadNum() const
+  {
+    return workers.size() + 1;
+  }
+
+  // 对 [0, ThreadNum()) 中每个块调用一次 _task(_context, chunkIdx)，全部完成后返回
+  void Run(
+      void (*_task)(void *, size_t),
+      void *_context)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      task = _task;
+      context = _context;
+      pendingNum = workers.size();
+      ++generation;
+    }
+    wakeCond.notify_all();
+    _task(_context, 0);
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCond.wait(lock, [&]
+                  { return pendingNum == 0; });
+  }
+};
@@ -16,14 +16,36 @@
 
 #include "LocalMIP.h"
 
-// 计算当前变量的调整对目标函数和约束的评分
+// 计算当前变量的调整对目标函数和约束的评分；按变量是否出现在目标函数中选定特化版本
 long LocalMIP::TightScore(
     const ModelVar &_modelVar, // 模型变量
     Value _delta)              // 调整量
+{
+  // 列内约束下标递增，目标函数若出现必为第一项
+  if (_modelVar.termNum > 0 && _modelVar.conIdxSet[0] == 0)
+    return TightScoreImpl<true, false>(_modelVar, _delta, subscore);
+  return TightScoreImpl<false, false>(_modelVar, _delta, subscore);
+}
+
+// 只读版本：子评分经 _subscore 返回，不读写评分缓存与计数器，可由多个线程同时调用
+long LocalMIP::TightScoreShared(
+    const ModelVar &_modelVar, // 模型变量
+    Value _delta,              // 调整量
+    long &_subscore)           // 返回的子评分
+{
+  if (_modelVar.termNum > 0 && _modelVar.conIdxSet[0] == 0)
+    return TightScoreImpl<true, true>(_modelVar, _delta, _subscore);
+  return TightScoreImpl<false, true>(_modelVar, _delta, _subscore);
+}
+
+template <bool isObjVar, bool isShared>
+long LocalMIP::TightScoreImpl(
+    const ModelVar &_modelVar, // 模型变量
+    Value _delta,              // 调整量
+    long &_subscore)           // 返回的子评分
 {
   long score = 0;              // 总评分
   size_t conIdx;               // 约束索引
-  size_t posInCon;             // 约束中的位置
   Value newLHS;                // 调整后的约束左侧值
   Value newOBJ;                // 调整后的目标函数值
   bool isPreSat;               // 调整前是否满足约束
@@ -32,95 +54,198 @@ long LocalMIP::TightScore(
   bool isNowStable;            // 调整后是否稳定
   bool isPreBetter;            // 调整前目标函数是否更优
   bool isNowBetter;            // 调整后目标函数是否更优
-  subscore = 0;                // 子评分（用于额外评分）
+  long subscore = 0;           // 子评分（用于额外评分）
 
-  // 遍历模型变量的所有项
-  for (size_t termIdx = 0; termIdx < _modelVar.termNum; ++termIdx)
+  size_t termIdx = 0;
+  if (isObjVar)
   {
-    conIdx = _modelVar.conIdxSet[termIdx];
-    posInCon = _modelVar.posInCon[termIdx];
-    auto &localCon = localConUtil.conSet[conIdx];
-    auto &modelCon = modelConUtil->conSet[conIdx];
-
-    if (conIdx == 0) // 如果是目标函数
+    auto &localObj = localConUtil.conSet[0];
+    if (isFoundFeasible) // 如果已经找到可行解
     {
-      if (isFoundFeasible) // 如果已经找到可行解
-      {
-        newOBJ = localCon.LHS + modelCon.coeffSet[posInCon] * _delta;
-        // 判断目标函数是否更优
-        if (newOBJ < localCon.LHS)
-          score += localCon.weight; // 更优则加分
-        else
-          score -= localCon.weight; // 否则减分
-
-        isPreBetter = localCon.LHS < localCon.RHS;
-        isNowBetter = newOBJ < localCon.RHS;
-        // 更新子评分
-        if (!isPreBetter && isNowBetter)
-          subscore += localCon.weight;
-        else if (isPreBetter && !isNowBetter)
-          subscore -= localCon.weight;
-      }
+      newOBJ = localObj.LHS + _modelVar.coeffSet[0] * _delta;
+      // 判断目标函数是否更优
+      if (newOBJ < localObj.LHS)
+        score += localObj.weight; // 更优则加分
+      else
+        score -= localObj.weight; // 否则减分
+
+      isPreBetter = localObj.LHS < localObj.RHS;
+      isNowBetter = newOBJ < localObj.RHS;
+      // 更新子评分
+      if (!isPreBetter && isNowBetter)
+        subscore += localObj.weight;
+      else if (isPreBetter && !isNowBetter)
+        subscore -= localObj.weight;
     }
-    else // 如果是普通约束
+    termIdx = 1;
+  }
+
+  // 约束部分的评分只依赖所在约束的 LHS 与权重，可按 (变量, delta) 缓存
+  size_t varIdx = _modelVar.idx;
+  if (!isShared && isScoreCache)
+  {
+    ++cacheLookupNum;
+    if (localVarUtil.cacheStamp[varIdx] == cacheEpoch &&
+        localVarUtil.cacheDelta[varIdx] == _delta)
     {
-      newLHS = localCon.LHS + modelCon.coeffSet[posInCon] * _delta;
-      isPreSat = localCon.SAT(); // 调整前是否满足约束
-      isNowSat = newLHS < localCon.RHS + FeasibilityTol; // 调整后是否满足约束
-      // 更新评分
-      if (!isPreSat && isNowSat)
-        score += localCon.weight; // 从不满足到满足，加分
-      else if (isPreSat && !isNowSat)
-        score -= localCon.weight; // 从满足到不满足，减分
-      else if (!isPreSat && !isNowSat)
-        if (localCon.LHS > newLHS)
-          score += localCon.weight >> 1; // 更接近满足约束，加分（权重减半）
-        else
-          score -= localCon.weight >> 1; // 更远离满足约束，减分（权重减半）
-
-      isPreStable = localCon.LHS < localCon.RHS - FeasibilityTol;
-      isNowStable = newLHS < localCon.RHS - FeasibilityTol;
-      // 更新子评分
-      if (!isPreStable && isNowStable)
-        subscore += localCon.weight;
-      else if (isPreStable && !isNowStable)
-        subscore -= localCon.weight;
+      ++cacheHitNum;
+      _subscore = subscore + localVarUtil.cacheSubscore[varIdx];
+      return score + localVarUtil.cacheScore[varIdx];
     }
   }
+  long objScore = score;
+  long objSubscore = subscore;
+  if (!isShared)
+    workUnits += _modelVar.termNum;
+
+  // 长列交给向量化内核，结果与下面的标量循环逐位一致
+  if (isSimdScore && _modelVar.termNum - termIdx >= simdMinTermNum)
+  {
+    score += TightScoreAVX2(_modelVar, termIdx, _delta, subscore);
+    termIdx = _modelVar.termNum;
+  }
+
+  // 遍历其余的普通约束
+  for (; termIdx < _modelVar.termNum; ++termIdx)
+  {
+    conIdx = _modelVar.conIdxSet[termIdx];
+    auto &localCon = localConUtil.conSet[conIdx];
+    newLHS = localCon.LHS + _modelVar.coeffSet[termIdx] * _delta;
+    isPreSat = localCon.LHS < localCon.RHS + FeasibilityTol; // 调整前是否满足约束
+    isNowSat = newLHS < localCon.RHS + FeasibilityTol; // 调整后是否满足约束
+    // 更新评分
+    if (!isPreSat && isNowSat)
+      score += localCon.weight; // 从不满足到满足，加分
+    else if (isPreSat && !isNowSat)
+      score -= localCon.weight; // 从满足到不满足，减分
+    else if (!isPreSat && !isNowSat)
+      if (localCon.LHS > newLHS)
+        score += localCon.weight >> 1; // 更接近满足约束，加分（权重减半）
+      else
+        score -= localCon.weight >> 1; // 更远离满足约束，减分（权重减半）
+
+    isPreStable = localCon.LHS < localCon.RHS - FeasibilityTol;
+    isNowStable = newLHS < localCon.RHS - FeasibilityTol;
+    // 更新子评分
+    if (!isPreStable && isNowStable)
+      subscore += localCon.weight;
+    else if (isPreStable && !isNowStable)
+      subscore -= localCon.weight;
+
+    // 区间约束的下界一侧按 -a·x <= -lowerRHS 同样评分
+    if (localCon.lowerRHS != NegativeInfinity)
+      score += LocalCon::SideScore(
+          -localCon.LHS, -newLHS, -localCon.lowerRHS, localConUtil.lowerWeights[conIdx], subscore);
+  }
+  if (!isShared && isScoreCache)
+  {
+    localVarUtil.cacheStamp[varIdx] = cacheEpoch;
+    localVarUtil.cacheDelta[varIdx] = _delta;
+    localVarUtil.cacheScore[varIdx] = score - objScore;
+    localVarUtil.cacheSubscore[varIdx] = subscore - objSubscore;
+  }
+  _subscore = subscore;
   return score; // 返回总评分
 }
 
-// 计算调整量 delta_x，使得 a * delta_x + gap <= 0
+// 约束的 LHS 或权重变化后，使该约束中所有变量的缓存失效
+void LocalMIP::InvalidateScoreCache(
+    size_t _conIdx)
+{
+  const auto &modelCon = modelConUtil->conSet[_conIdx];
+  for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+    localVarUtil.cacheStamp[modelCon.varIdxSet[termIdx]] = 0;
+}
+
+// 计算调整量 delta_x，使得 a * delta_x + gap <= 0；违反下界时以下界一侧为准，否则取上界一侧
 bool LocalMIP::TightDelta(
     LocalCon &_localCon,    // 局部约束
     const ModelCon &_modelCon, // 模型约束
     size_t _termIdx,        // 项索引
     Value &_res)            // 返回的调整量
 {
-  Value gap = _localCon.LHS - _localCon.RHS; // 当前约束的间隙
-  auto varIdx = _modelCon.varIdxSet[_termIdx];
-  auto &localVar = localVarUtil.GetVar(varIdx);
-  auto &modelVar = modelVarUtil->GetVar(varIdx);
-  Value delta = -(gap / _modelCon.coeffSet[_termIdx]); // 计算理论调整量
-
-  // 根据系数符号和变量类型调整 delta
-  if (_modelCon.coeffSet[_termIdx] > 0)
-  {
-    if (modelVar.type == VarType::Real)
-      _res = delta; // 实数变量直接使用 delta
-    else
-      _res = floor(delta); // 整数变量向下取整
-  }
+  return TightDelta(_localCon, _modelCon, _termIdx, _localCon.BelowLower(), _res);
+}
+
+// 指定一侧：上界一侧使 LHS 降到 RHS，下界一侧使 LHS 升到 lowerRHS；按变量类型选定特化版本
+bool LocalMIP::TightDelta(
+    LocalCon &_localCon,    // 局部约束
+    const ModelCon &_modelCon, // 模型约束
+    size_t _termIdx,        // 项索引
+    bool _isLowerSide,      // 是否按下界一侧计算
+    Value &_res)            // 返回的调整量
+{
+  const auto &modelVar = modelVarUtil->GetVar(_modelCon.varIdxSet[_termIdx]);
+  ++workUnits;
+  if (isIntEngine && _modelCon.idx > 0)
+    return TightDeltaExact(_localCon, _modelCon, modelVar, _termIdx, _isLowerSide, _res);
+  if (modelVar.type == VarType::Real)
+    return TightDeltaImpl<true>(_localCon, _modelCon, modelVar, _termIdx, _isLowerSide, _res);
+  return TightDeltaImpl<false>(_localCon, _modelCon, modelVar, _termIdx, _isLowerSide, _res);
+}
+
+template <bool isReal>
+bool LocalMIP::TightDeltaImpl(
+    const LocalCon &_localCon,  // 局部约束
+    const ModelCon &_modelCon,  // 模型约束
+    const ModelVar &_modelVar,  // 该项对应的模型变量
+    size_t _termIdx,            // 项索引
+    bool _isLowerSide,          // 是否按下界一侧计算
+    Value &_res)                // 返回的调整量
+{
+  // 下界一侧等价于 -a·x <= -lowerRHS
+  Value gap = _isLowerSide ? _localCon.lowerRHS - _localCon.LHS
+                           : _localCon.LHS - _localCon.RHS; // 当前约束的间隙
+  Value coeff = _isLowerSide ? -_modelCon.coeffSet[_termIdx] : _modelCon.coeffSet[_termIdx];
+  Value delta = -(gap / coeff); // 计算理论调整量
+
+  // 实数变量直接使用 delta；整数变量按系数符号取整
+  if (isReal)
+    _res = delta;
+  else if (coeff > 0)
+    _res = floor(delta); // 整数变量向下取整
+  else
+    _res = ceil(delta);  // 整数变量向上取整
+
+  // 检查调整后的值是否在变量边界内（同 ModelVar::InBound）
+  Value newValue = localVarUtil.GetVar(_modelVar.idx).nowValue + _res;
+  return _modelVar.lowerBound - FeasibilityTol < newValue &&
+         newValue < _modelVar.upperBound + FeasibilityTol;
+}
+
+// 整数引擎：系数、约束两侧、变量值与边界都是 2^53 以内的整数，按 int64 整数除法精确取整，边界比较无需容差
+// 目标函数的 RHS 为 bestOBJ - OptimalTol，不是整数，仍走浮点版本
+bool LocalMIP::TightDeltaExact(
+    const LocalCon &_localCon,  // 局部约束
+    const ModelCon &_modelCon,  // 模型约束
+    const ModelVar &_modelVar,  // 该项对应的模型变量
+    size_t _termIdx,            // 项索引
+    bool _isLowerSide,          // 是否按下界一侧计算
+    Value &_res)                // 返回的调整量
+{
+  int64_t LHS = (int64_t)_localCon.LHS;
+  int64_t gap = _isLowerSide ? (int64_t)_localCon.lowerRHS - LHS
+                             : LHS - (int64_t)_localCon.RHS;
+  int64_t coeff = (int64_t)_modelCon.coeffSet[_termIdx];
+  if (_isLowerSide)
+    coeff = -coeff;
+
+  // a * delta <= -gap 的整数解：a > 0 取 floor(-gap / a)，a < 0 取 ceil(-gap / a)
+  // 单位系数无需除法；否则整数除法向零截断，-gap 为负且有余数时向外修正一位
+  int64_t delta;
+  if (coeff == 1 || coeff == -1)
+    delta = -gap * coeff;
   else
   {
-    if (modelVar.type == VarType::Real)
-      _res = delta; // 实数变量直接使用 delta
-    else
-      _res = ceil(delta); // 整数变量向上取整
+    delta = -gap / coeff;
+    if (gap > 0 && gap % coeff != 0)
+      delta += coeff > 0 ? -1 : 1;
   }
 
-  // 检查调整后的值是否在变量边界内
-  return modelVar.InBound(localVar.nowValue + _res);
+  int64_t newValue = (int64_t)localVarUtil.GetVar(_modelVar.idx).nowValue + delta;
+  _res = delta;
+  return (int64_t)_modelVar.lowerBound <= newValue &&
+         newValue <= (int64_t)_modelVar.upperBound;
 }
 
 // 更新权重：对不满足的约束增加权重，如果所有约束满足且找到可行解，则增加目标函数权重
@@ -129,17 +254,84 @@ void LocalMIP::UpdateWeight()
   for (size_t conIdx : localConUtil.unsatConIdxs)
   {
     auto &localCon = localConUtil.conSet[conIdx];
-    ++localCon.weight; // 不满足的约束权重加 1
+    size_t oldWeight = localCon.weight;
+    size_t oldLowerWeight = localConUtil.lowerWeights[conIdx];
+    if (localCon.BelowLower())
+      ++localConUtil.lowerWeights[conIdx]; // 违反下界一侧，该侧权重加 1
+    else
+      ++localCon.weight; // 不满足的约束权重加 1
+    if (isScoreCache)
+      InvalidateScoreCache(conIdx);
+    if (isFlipEngine)
+      FlipEngineWeightChange(conIdx, oldWeight, oldLowerWeight);
   }
   auto &localObj = localConUtil.conSet[0]; // 目标函数
   if (isFoundFeasible && localConUtil.unsatConIdxs.empty())
+  {
     ++localObj.weight; // 如果找到可行解且所有约束满足，目标函数权重加 1
+    if (isFlipEngine)
+      FlipEngineObjWeightChange(localObj.weight - 1);
+  }
 }
 
-// 平滑权重：对满足的约束且权重大于 0 的，权重减 1
+// 平滑权重：对满足的约束且权重大于 0 的，权重减 1；区间约束两侧分别处理
 void LocalMIP::SmoothWeight()
 {
-  for (auto &localCon : localConUtil.conSet)
-    if (localCon.SAT() && localCon.weight > 0)
+  ++cacheEpoch; // 几乎所有约束权重都会变化，整体失效
+  for (size_t conIdx = 0; conIdx < localConUtil.conSet.size(); ++conIdx)
+  {
+    auto &localCon = localConUtil.conSet[conIdx];
+    if (localCon.LHS < localCon.RHS + FeasibilityTol && localCon.weight > 0)
       --localCon.weight; // 满足的约束权重减 1
-}
\ No newline at end of file
+    size_t &lowerWeight = localConUtil.lowerWeights[conIdx];
+    if (localCon.LHS > localCon.lowerRHS - FeasibilityTol && lowerWeight > 0)
+      --lowerWeight;
+  }
+  if (isFlipEngine)
+    InitFlipEngine();
+}
+// 从候选列表 tempVarIdxs/tempDeltas 中按 VarValue 加权无放回抽取 _sampleNum 个，放到列表前部
+void LocalMIP::SampleNeighborByValue(
+    size_t _sampleNum)
+{
+  vector<size_t> &neighborVarIdxs = localVarUtil.tempVarIdxs;
+  vector<Value> &neighborDeltas = localVarUtil.tempDeltas;
+  vector<size_t> &sampleVarIdxs = localVarUtil.bmsVarIdxs;
+  vector<Value> &sampleDeltas = localVarUtil.bmsDeltas;
+  auto &sampler = localVarUtil.bmsSampler;
+  // 价值可能因目标变差而为负，取下限保证每个候选都有被抽中的机会
+  sampler.Build(
+      neighborVarIdxs.size(),
+      [&](size_t _pos)
+      { return max(VarValue[neighborVarIdxs[_pos]], 0.01); });
+  sampleVarIdxs.clear();
+  sampleDeltas.clear();
+  for (size_t sampleIdx = 0; sampleIdx < _sampleNum; ++sampleIdx)
+  {
+    size_t pos = sampler.Draw(rng.Uniform());
+    sampleVarIdxs.push_back(neighborVarIdxs[pos]);
+    sampleDeltas.push_back(neighborDeltas[pos]);
+  }
+  // 抽中的位置可能位于前部，先全部取出再写回
+  for (size_t sampleIdx = 0; sampleIdx < _sampleNum; ++sampleIdx)
+  {
+    neighborVarIdxs[sampleIdx] = sampleVarIdxs[sampleIdx];
+    neighborDeltas[sampleIdx] = sampleDeltas[sampleIdx];
+  }
+}
+
+// 用最近 5 次移动的目标改进（指数折扣）累加变量价值
+void LocalMIP::UpdateVarValue(
+    size_t _varIdx,
+    Value _preOBJ)
+{
+  reward[_varIdx][Varindex[_varIdx]] =
+      (_preOBJ - localConUtil.conSet[0].LHS) / (_preOBJ - bestOBJ + 1);
+  double gamma = pow(0.89, 4);
+  for (size_t idx = 1; idx <= 5; ++idx)
+  {
+    VarValue[_varIdx] += gamma * reward[_varIdx][(idx + Varindex[_varIdx]) % 5];
+    gamma /= 0.89;
+  }
+  Varindex[_varIdx] = (Varindex[_varIdx] + 1) % 5;
+}
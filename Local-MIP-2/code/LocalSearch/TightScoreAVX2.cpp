@@ -0,0 +1,152 @@
+/*=====================================================================================
+
+    Filename:     TightScoreAVX2.cpp
+
+    Description:  AVX2 kernel of TightScore for the constraint part of a column
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "LocalMIP.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+
+bool LocalMIP::SupportAVX2()
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+// 一侧 LHS <= RHS 对 4 个约束的评分，逻辑同 LocalCon::SideScore
+__attribute__((target("avx2"))) static inline void SideScoreAVX2(
+    __m256d _LHS,
+    __m256d _newLHS,
+    __m256d _RHS,
+    __m256i _weight,
+    __m256i &_scoreVec,
+    __m256i &_subscoreVec)
+{
+  const __m256d tolVec = _mm256_set1_pd(FeasibilityTol);
+  __m256i halfWeight = _mm256_srli_epi64(_weight, 1);
+  __m256d satBound = _mm256_add_pd(_RHS, tolVec);
+  __m256d stableBound = _mm256_sub_pd(_RHS, tolVec);
+  __m256i isPreSat = _mm256_castpd_si256(_mm256_cmp_pd(_LHS, satBound, _CMP_LT_OQ));
+  __m256i isNowSat = _mm256_castpd_si256(_mm256_cmp_pd(_newLHS, satBound, _CMP_LT_OQ));
+  __m256i isCloser = _mm256_castpd_si256(_mm256_cmp_pd(_LHS, _newLHS, _CMP_GT_OQ));
+  __m256i isPreStable = _mm256_castpd_si256(_mm256_cmp_pd(_LHS, stableBound, _CMP_LT_OQ));
+  __m256i isNowStable = _mm256_castpd_si256(_mm256_cmp_pd(_newLHS, stableBound, _CMP_LT_OQ));
+
+  // 不满足->满足 +w；满足->不满足 -w；一直不满足则按是否更接近 ±w/2
+  __m256i makeSat = _mm256_andnot_si256(isPreSat, isNowSat);
+  __m256i breakSat = _mm256_andnot_si256(isNowSat, isPreSat);
+  __m256i stayUnsat = _mm256_andnot_si256(_mm256_or_si256(isPreSat, isNowSat),
+                                          _mm256_set1_epi64x(-1));
+  __m256i closer = _mm256_and_si256(stayUnsat, isCloser);
+  __m256i farther = _mm256_andnot_si256(isCloser, stayUnsat);
+  _scoreVec = _mm256_add_epi64(_scoreVec, _mm256_and_si256(makeSat, _weight));
+  _scoreVec = _mm256_sub_epi64(_scoreVec, _mm256_and_si256(breakSat, _weight));
+  _scoreVec = _mm256_add_epi64(_scoreVec, _mm256_and_si256(closer, halfWeight));
+  _scoreVec = _mm256_sub_epi64(_scoreVec, _mm256_and_si256(farther, halfWeight));
+
+  __m256i makeStable = _mm256_andnot_si256(isPreStable, isNowStable);
+  __m256i breakStable = _mm256_andnot_si256(isNowStable, isPreStable);
+  _subscoreVec = _mm256_add_epi64(_subscoreVec, _mm256_and_si256(makeStable, _weight));
+  _subscoreVec = _mm256_sub_epi64(_subscoreVec, _mm256_and_si256(breakStable, _weight));
+}
+
+// 每次处理 4 个约束：按 conIdx 从 LocalCon{LHS, RHS, lowerRHS, weight} 中 gather，
+// 用比较掩码代替分支；乘加分开计算，保证与标量版本逐位一致。
+// 4 个约束都是单侧约束时跳过下界一侧，此时不访问 lowerWeights
+__attribute__((target("avx2")))
+long LocalMIP::TightScoreAVX2(
+    const ModelVar &_modelVar,
+    size_t _termBegin,
+    Value _delta,
+    long &_subscore)
+{
+  static_assert(sizeof(LocalCon) == 4 * sizeof(double), "LocalCon layout");
+  const double *conBase = reinterpret_cast<const double *>(localConUtil.conSet.data());
+  const long long *weightBase = reinterpret_cast<const long long *>(conBase + 3);
+  const long long *lowerWeightBase =
+      reinterpret_cast<const long long *>(localConUtil.lowerWeights.data());
+  const __m256d deltaVec = _mm256_set1_pd(_delta);
+  const __m256d negInfVec = _mm256_set1_pd(NegativeInfinity);
+  const __m256d signVec = _mm256_set1_pd(-0.0);
+  __m256i scoreVec = _mm256_setzero_si256();
+  __m256i subscoreVec = _mm256_setzero_si256();
+
+  size_t termIdx = _termBegin;
+  for (; termIdx + 4 <= _modelVar.termNum; termIdx += 4)
+  {
+    __m256i conIdx;
+    if constexpr (sizeof(Index) == 4)
+      conIdx = _mm256_cvtepu32_epi64(_mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(_modelVar.conIdxSet + termIdx)));
+    else
+      conIdx = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(_modelVar.conIdxSet + termIdx));
+    __m256i offset = _mm256_slli_epi64(conIdx, 2);
+    __m256d LHS = _mm256_i64gather_pd(conBase, offset, 8);
+    __m256d RHS = _mm256_i64gather_pd(conBase + 1, offset, 8);
+    __m256i weight = _mm256_i64gather_epi64(weightBase, offset, 8);
+    __m256d coeff = _mm256_loadu_pd(_modelVar.coeffSet + termIdx);
+    __m256d newLHS = _mm256_add_pd(LHS, _mm256_mul_pd(coeff, deltaVec));
+    SideScoreAVX2(LHS, newLHS, RHS, weight, scoreVec, subscoreVec);
+
+    // 下界一侧按 -a·x <= -lowerRHS 评分；单侧约束的 lowerRHS 为负无穷，取反后恒满足且稳定
+    __m256d lowerRHS = _mm256_i64gather_pd(conBase + 2, offset, 8);
+    if (_mm256_movemask_pd(_mm256_cmp_pd(lowerRHS, negInfVec, _CMP_NEQ_OQ)))
+    {
+      __m256i lowerWeight = _mm256_i64gather_epi64(lowerWeightBase, conIdx, 8);
+      SideScoreAVX2(_mm256_xor_pd(LHS, signVec), _mm256_xor_pd(newLHS, signVec),
+                    _mm256_xor_pd(lowerRHS, signVec), lowerWeight, scoreVec, subscoreVec);
+    }
+  }
+
+  alignas(32) long long scoreLane[4];
+  alignas(32) long long subscoreLane[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(scoreLane), scoreVec);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(subscoreLane), subscoreVec);
+  long score = scoreLane[0] + scoreLane[1] + scoreLane[2] + scoreLane[3];
+  _subscore += subscoreLane[0] + subscoreLane[1] + subscoreLane[2] + subscoreLane[3];
+
+  // 尾部不足 4 项的约束走标量逻辑
+  for (; termIdx < _modelVar.termNum; ++termIdx)
+  {
+    size_t conIdx = _modelVar.conIdxSet[termIdx];
+    auto &localCon = localConUtil.conSet[conIdx];
+    Value newLHS = localCon.LHS + _modelVar.coeffSet[termIdx] * _delta;
+    score += LocalCon::SideScore(localCon.LHS, newLHS, localCon.RHS, localCon.weight, _subscore);
+    if (localCon.lowerRHS != NegativeInfinity)
+      score += LocalCon::SideScore(
+          -localCon.LHS, -newLHS, -localCon.lowerRHS, localConUtil.lowerWeights[conIdx], _subscore);
+  }
+  return score;
+}
+
+#else
+
+bool LocalMIP::SupportAVX2()
+{
+  return false;
+}
+
+long LocalMIP::TightScoreAVX2(
+    const ModelVar &_modelVar,
+    size_t _termBegin,
+    Value _delta,
+    long &_subscore)
+{
+  assert(false);
+  return 0;
+}
+
+#endif
@@ -19,7 +19,8 @@
 bool LocalMIP::UnsatTightMove()
 {
   vector<bool> &scoreTable = localVarUtil.scoreTable; // 记录变量是否已被评分的表
-  vector<size_t> scoreIdxs; // 记录已评分变量的索引
+  vector<size_t> &scoreIdxs = localVarUtil.scoreIdxs; // 记录已评分变量的索引
+  scoreIdxs.clear();
   long bestScore = 0; // 最佳得分
   long bestSubscore = -std::numeric_limits<long>::max(); // 次佳得分
   size_t bestVarIdx = -1; // 最佳变量的索引
@@ -47,7 +48,7 @@ bool LocalMIP::UnsatTightMove()
           localConUtil.unsatConIdxs.begin(), localConUtil.unsatConIdxs.end());
       for (size_t sampleIdx = 0; sampleIdx < sampleUnsat; ++sampleIdx)
       {
-        size_t randomIdx = mt() % (neighborConIdxs->size() - sampleIdx);
+        size_t randomIdx = rng.Bounded(neighborConIdxs->size() - sampleIdx);
         size_t temp = neighborConIdxs->at(sampleIdx);
         neighborConIdxs->at(sampleIdx) = neighborConIdxs->at(randomIdx + sampleIdx);
         neighborConIdxs->at(randomIdx + sampleIdx) = temp;
@@ -66,10 +67,10 @@ bool LocalMIP::UnsatTightMove()
         auto &localVar = localVarUtil.GetVar(varIdx);
         auto &modelVar = modelVarUtil->GetVar(varIdx);
 
-        // 计算使约束更紧的变化值 delta
+        // 计算使约束更紧的变化值 delta；违反下界时朝增大 LHS 的方向取边界
         Value delta;
         if (!TightDelta(localCon, modelCon, termIdx, delta))
-          if (modelCon.coeffSet[termIdx] > 0)
+          if ((modelCon.coeffSet[termIdx] > 0) != localCon.BelowLower())
             delta = modelVar.lowerBound - localVar.nowValue;
           else
             delta = modelVar.upperBound - localVar.nowValue;
@@ -128,49 +129,58 @@ bool LocalMIP::UnsatTightMove()
       scoreSize = bmsUnsatInfeas;
     else
       scoreSize = bmsUnsatFeas;
-    for (size_t bmsIdx = 0; bmsIdx < scoreSize; ++bmsIdx)
-    {
-      size_t randomIdx = (mt() % (neighborVarIdxs.size() - bmsIdx)) + bmsIdx;
-      size_t varIdx = neighborVarIdxs[randomIdx];
-      Value delta = neighborDeltas[randomIdx];
-      neighborVarIdxs[randomIdx] = neighborVarIdxs[bmsIdx];
-      neighborDeltas[randomIdx] = neighborDeltas[bmsIdx];
-      neighborVarIdxs[bmsIdx] = varIdx;
-      neighborDeltas[bmsIdx] = delta;
-    }
+    if (isBmsValue)
+      SampleNeighborByValue(scoreSize); // 按变量价值加权抽样
+    else
+      for (size_t bmsIdx = 0; bmsIdx < scoreSize; ++bmsIdx)
+      {
+        size_t randomIdx = rng.Bounded(neighborVarIdxs.size() - bmsIdx) + bmsIdx;
+        size_t varIdx = neighborVarIdxs[randomIdx];
+        Value delta = neighborDeltas[randomIdx];
+        neighborVarIdxs[randomIdx] = neighborVarIdxs[bmsIdx];
+        neighborDeltas[randomIdx] = neighborDeltas[bmsIdx];
+        neighborVarIdxs[bmsIdx] = varIdx;
+        neighborDeltas[bmsIdx] = delta;
+      }
   }
 
   // 第四部分：评估候选变量并选择最佳移动
-  for (size_t idx = 0; idx < scoreSize; ++idx)
+  if (IsParallelScore(scoreSize))
   {
-    size_t varIdx = neighborVarIdxs[idx];
-    Value delta = neighborDeltas[idx];
-    auto &localVar = localVarUtil.GetVar(varIdx);
-    auto &modelVar = modelVarUtil->GetVar(varIdx);
-
-    // 处理二进制变量：避免重复评分
-    if (modelVar.type == VarType::Binary)
+    scoreSize = SkipScoredBinary(scoreSize, scoreTable, scoreIdxs);
+    ParallelScore(scoreSize, bestScore, bestSubscore, bestVarIdx, bestDelta);
+  }
+  else
+    for (size_t idx = 0; idx < scoreSize; ++idx)
     {
-      if (scoreTable[varIdx])
-        continue;
-      else
+      size_t varIdx = neighborVarIdxs[idx];
+      Value delta = neighborDeltas[idx];
+      auto &localVar = localVarUtil.GetVar(varIdx);
+      auto &modelVar = modelVarUtil->GetVar(varIdx);
+
+      // 处理二进制变量：避免重复评分
+      if (modelVar.type == VarType::Binary)
       {
-        scoreTable[varIdx] = true;
-        scoreIdxs.push_back(varIdx);
+        if (scoreTable[varIdx])
+          continue;
+        else
+        {
+          scoreTable[varIdx] = true;
+          scoreIdxs.push_back(varIdx);
+        }
       }
-    }
 
-    // 计算移动的得分
-    long score = TightScore(modelVar, delta);
-    if (bestScore < score ||
-        bestScore == score && bestSubscore < subscore)
-    {
-      bestScore = score;
-      bestVarIdx = varIdx;
-      bestDelta = delta;
-      bestSubscore = subscore;
+      // 计算移动的得分
+      long score = TightScore(modelVar, delta);
+      if (bestScore < score ||
+          bestScore == score && bestSubscore < subscore)
+      {
+        bestScore = score;
+        bestVarIdx = varIdx;
+        bestDelta = delta;
+        bestSubscore = subscore;
+      }
     }
-  }
 
   // 第五部分：应用最佳移动（如果找到）
   if (bestScore > 0)
@@ -178,7 +188,10 @@ bool LocalMIP::UnsatTightMove()
     if (DEBUG)
       printf("UNSAT: %-10ld; ", bestScore);
     ++tightStepUnsat; // 更新统计信息
+    Value preOBJ = localConUtil.conSet[0].LHS;
     ApplyMove(bestVarIdx, bestDelta); // 应用移动
+    if (isBmsValue && isFoundFeasible)
+      UpdateVarValue(bestVarIdx, preOBJ);
     PickVar[bestVarIdx]++;
     for (auto idx : scoreIdxs)
       scoreTable[idx] = false; // 重置评分表
@@ -186,12 +199,15 @@ bool LocalMIP::UnsatTightMove()
   }
   else
   {
-    // 如果没有找到有效移动，尝试其他移动策略
+    // 如果没有找到有效移动，尝试其他移动策略（由调度器选择算子时不级联）
     bool resFurtherMove = false;
-    if (isFoundFeasible)
-      resFurtherMove = SatTightMove(scoreTable, scoreIdxs); // 尝试满足约束的移动
-    if (!resFurtherMove)
-      resFurtherMove = FlipMove(scoreTable, scoreIdxs); // 尝试翻转移动
+    if (scheduler == FixedChain)
+    {
+      if (isFoundFeasible)
+        resFurtherMove = SatTightMove(scoreTable, scoreIdxs); // 尝试满足约束的移动
+      if (!resFurtherMove)
+        resFurtherMove = FlipMove(scoreTable, scoreIdxs); // 尝试翻转移动
+    }
     for (auto idx : scoreIdxs)
       scoreTable[idx] = false; // 重置评分表
     return resFurtherMove;
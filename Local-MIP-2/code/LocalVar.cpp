@@ -28,30 +28,77 @@ LocalVar::~LocalVar()
 {
 }
 
+LocalVarHistory::LocalVarHistory()
+{
+}
+
+LocalVarHistory::~LocalVarHistory()
+{
+}
+
 LocalVarUtil::LocalVarUtil()
 {
 }
 
 void LocalVarUtil::Allocate(
     size_t _varNum,
-    size_t _varNumInObj)
+    size_t _varNumInObj,
+    size_t _neighborCapacity)
 {
-  tempDeltas.reserve(_varNum);
-  tempVarIdxs.reserve(_varNum);
-  affectedVar.reserve(_varNum);
+  tempDeltas.reserve(_neighborCapacity);
+  tempVarIdxs.reserve(_neighborCapacity);
+  scoreIdxs.reserve(_varNum);
+  bmsVarIdxs.reserve(_neighborCapacity);
+  bmsDeltas.reserve(_neighborCapacity);
+  bmsSampler.Reserve(_neighborCapacity);
+  affectedVarIdxs.reserve(_varNum);
+  affectedStamp.resize(_varNum, 0);
+  affectedEpoch = 0;
   varSet.resize(_varNum);
+  historySet.resize(_varNum);
   scoreTable.resize(_varNum, false);
   lowerDeltaInLiftMove.resize(_varNumInObj);
   upperDeltaInLifiMove.resize(_varNumInObj);
 }
 
+void LocalVarUtil::AllocateScoreCache(
+    size_t _varNum)
+{
+  cacheDelta.resize(_varNum, 0);
+  cacheScore.resize(_varNum, 0);
+  cacheSubscore.resize(_varNum, 0);
+  cacheStamp.resize(_varNum, 0);
+}
+
+void LocalVarUtil::AllocateFlipEngine(
+    size_t _varNum)
+{
+  flipScore.resize(_varNum, 0);
+  flipSubscore.resize(_varNum, 0);
+  posInFlipHeap.resize(_varNum, -1);
+  flipHeap.reserve(binaryIdx.size());
+  valueBits.resize((_varNum + 63) / 64, 0);
+}
+
 LocalVarUtil::~LocalVarUtil()
 {
+  flipScore.clear();
+  flipSubscore.clear();
+  flipHeap.clear();
+  posInFlipHeap.clear();
+  valueBits.clear();
+  cacheDelta.clear();
+  cacheScore.clear();
+  cacheSubscore.clear();
+  cacheStamp.clear();
   lowerDeltaInLiftMove.clear();
   upperDeltaInLifiMove.clear();
   scoreTable.clear();
-  affectedVar.clear();
+  scoreIdxs.clear();
+  affectedVarIdxs.clear();
+  affectedStamp.clear();
   varSet.clear();
+  historySet.clear();
   tempDeltas.clear();
   tempVarIdxs.clear();
 }
@@ -61,4 +108,98 @@ LocalVar &LocalVarUtil::GetVar(
 {
   assert(_idx < varSet.size());
   return varSet[_idx];
-}
\ No newline at end of file
+}
+
+LocalVarHistory &LocalVarUtil::GetHistory(
+    size_t _idx)
+{
+  assert(_idx < historySet.size());
+  return historySet[_idx];
+}
+
+bool LocalVarUtil::GetValueBit(
+    size_t _idx) const
+{
+  return (valueBits[_idx >> 6] >> (_idx & 63)) & 1;
+}
+
+void LocalVarUtil::SetValueBit(
+    size_t _idx,
+    bool _value)
+{
+  if (_value)
+    valueBits[_idx >> 6] |= (uint64_t)1 << (_idx & 63);
+  else
+    valueBits[_idx >> 6] &= ~((uint64_t)1 << (_idx & 63));
+}
+
+void LocalVarUtil::FlipValueBit(
+    size_t _idx)
+{
+  valueBits[_idx >> 6] ^= (uint64_t)1 << (_idx & 63);
+}
+
+bool LocalVarUtil::IsBetterFlip(
+    size_t _idxA,
+    size_t _idxB) const
+{
+  return flipScore[_idxA] > flipScore[_idxB] ||
+         (flipScore[_idxA] == flipScore[_idxB] &&
+          flipSubscore[_idxA] > flipSubscore[_idxB]);
+}
+
+void LocalVarUtil::BuildFlipHeap()
+{
+  flipHeap.assign(binaryIdx.begin(), binaryIdx.end());
+  for (size_t pos = 0; pos < flipHeap.size(); ++pos)
+    posInFlipHeap[flipHeap[pos]] = pos;
+  for (size_t pos = flipHeap.size() / 2; pos-- > 0;)
+    SiftDownFlipHeap(pos);
+}
+
+void LocalVarUtil::UpdateFlipHeap(
+    size_t _idx)
+{
+  SiftUpFlipHeap(posInFlipHeap[_idx]);
+  SiftDownFlipHeap(posInFlipHeap[_idx]);
+}
+
+void LocalVarUtil::SiftUpFlipHeap(
+    size_t _pos)
+{
+  size_t idx = flipHeap[_pos];
+  while (_pos > 0)
+  {
+    size_t parentPos = (_pos - 1) >> 1;
+    if (!IsBetterFlip(idx, flipHeap[parentPos]))
+      break;
+    flipHeap[_pos] = flipHeap[parentPos];
+    posInFlipHeap[flipHeap[_pos]] = _pos;
+    _pos = parentPos;
+  }
+  flipHeap[_pos] = idx;
+  posInFlipHeap[idx] = _pos;
+}
+
+void LocalVarUtil::SiftDownFlipHeap(
+    size_t _pos)
+{
+  size_t idx = flipHeap[_pos];
+  size_t heapSize = flipHeap.size();
+  while (true)
+  {
+    size_t childPos = 2 * _pos + 1;
+    if (childPos >= heapSize)
+      break;
+    if (childPos + 1 < heapSize &&
+        IsBetterFlip(flipHeap[childPos + 1], flipHeap[childPos]))
+      ++childPos;
+    if (!IsBetterFlip(flipHeap[childPos], idx))
+      break;
+    flipHeap[_pos] = flipHeap[childPos];
+    posInFlipHeap[flipHeap[_pos]] = _pos;
+    _pos = childPos;
+  }
+  flipHeap[_pos] = idx;
+  posInFlipHeap[idx] = _pos;
+}
@@ -16,12 +16,13 @@
 
 #pragma once
 #include "utils/paras.h"
+#include "utils/Fenwick.h"
 
+// 候选筛选与打分时访问的热字段，禁忌过滤会同时读取 allow*/last* 步数
 class LocalVar
 {
 public:
   Value nowValue;
-  Value bestValue;
   size_t allowIncStep;
   size_t allowDecStep;
   size_t lastIncStep;
@@ -31,23 +32,73 @@ public:
   ~LocalVar();
 };
 
+// 仅在更新最优解、重启和输出解时访问的冷字段
+class LocalVarHistory
+{
+public:
+  Value bestValue;
+
+  LocalVarHistory();
+  ~LocalVarHistory();
+};
+
 class LocalVarUtil
 {
 public:
   vector<LocalVar> varSet;
+  vector<LocalVarHistory> historySet;
   vector<Value> lowerDeltaInLiftMove;
   vector<Value> upperDeltaInLifiMove;
   vector<Value> tempDeltas;
   vector<size_t> tempVarIdxs;
   vector<bool> scoreTable;
+  vector<Value> cacheDelta;
+  vector<long> cacheScore;
+  vector<long> cacheSubscore;
+  vector<size_t> cacheStamp;
   vector<size_t> binaryIdx;
-  unordered_set<size_t> affectedVar;
+  vector<long> flipScore;
+  vector<long> flipSubscore;
+  vector<size_t> flipHeap;
+  vector<size_t> posInFlipHeap;
+  vector<uint64_t> valueBits;
+  vector<size_t> scoreIdxs;
+  vector<size_t> bmsVarIdxs;
+  vector<Value> bmsDeltas;
+  FenwickSampler bmsSampler;
+  vector<size_t> affectedVarIdxs;
+  vector<size_t> affectedStamp;
+  size_t affectedEpoch;
 
   LocalVarUtil();
   ~LocalVarUtil();
   void Allocate(
       size_t _varNum,
-      size_t _varNumInObj);
+      size_t _varNumInObj,
+      size_t _neighborCapacity);
+  void AllocateScoreCache(
+      size_t _varNum);
   LocalVar &GetVar(
       size_t _idx);
+  LocalVarHistory &GetHistory(
+      size_t _idx);
+  void AllocateFlipEngine(
+      size_t _varNum);
+  bool GetValueBit(
+      size_t _idx) const;
+  void SetValueBit(
+      size_t _idx,
+      bool _value);
+  void FlipValueBit(
+      size_t _idx);
+  bool IsBetterFlip(
+      size_t _idxA,
+      size_t _idxB) const;
+  void BuildFlipHeap();
+  void UpdateFlipHeap(
+      size_t _idx);
+  void SiftUpFlipHeap(
+      size_t _pos);
+  void SiftDownFlipHeap(
+      size_t _pos);
 };
\ No newline at end of file
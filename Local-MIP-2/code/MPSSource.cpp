@@ -0,0 +1,348 @@
+/*=====================================================================================
+
+    Filename:     MPSSource.cpp
+
+    Description:  Zero-copy line and token access to MPS files
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "MPSSource.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#ifdef HAVE_BZIP2
+#include <bzlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+static const size_t StreamChunkSize = 1 << 20;
+
+MPSSource::MPSSource()
+    : data(nullptr),
+      size(0),
+      pos(0),
+      mapAddr(nullptr),
+      mapSize(0),
+      fd(-1),
+      codec(Codec::Plain),
+      isStream(false),
+      isEnd(false),
+      byteNum(0),
+      decoder(nullptr),
+      inPos(0),
+      inSize(0)
+{
+}
+
+MPSSource::~MPSSource()
+{
+  Close();
+}
+
+static Codec DetectCodec(
+    const unsigned char *_magic,
+    size_t _magicNum)
+{
+  if (_magicNum >= 2 && _magic[0] == 0x1f && _magic[1] == 0x8b)
+    return Codec::Gzip;
+  if (_magicNum >= 3 && _magic[0] == 'B' && _magic[1] == 'Z' && _magic[2] == 'h')
+    return Codec::Bzip2;
+  if (_magicNum >= 4 && _magic[0] == 0x28 && _magic[1] == 0xb5 &&
+      _magic[2] == 0x2f && _magic[3] == 0xfd)
+    return Codec::Zstd;
+  return Codec::Plain;
+}
+
+// 未压缩的普通文件直接映射；其余输入先读入一块，按魔数选择解压器后流式读取
+bool MPSSource::Open(
+    const char *_fileName)
+{
+  Close();
+  fd = open(_fileName, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0)
+  {
+    unsigned char magic[4];
+    ssize_t magicNum = pread(fd, magic, sizeof(magic), 0);
+    if (magicNum > 0 && DetectCodec(magic, magicNum) == Codec::Plain)
+    {
+      void *addr = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED)
+      {
+        madvise(addr, fileStat.st_size, MADV_SEQUENTIAL);
+        mapAddr = addr;
+        mapSize = fileStat.st_size;
+        data = static_cast<const char *>(addr);
+        size = mapSize;
+        byteNum = mapSize;
+        close(fd);
+        fd = -1;
+        return true;
+      }
+    }
+  }
+
+  isStream = true;
+  inBuffer.resize(StreamChunkSize);
+  while (inSize < 4)
+  {
+    ssize_t readNum = read(fd, inBuffer.data() + inSize, inBuffer.size() - inSize);
+    if (readNum <= 0)
+      break;
+    inSize += readNum;
+  }
+  codec = DetectCodec(reinterpret_cast<const unsigned char *>(inBuffer.data()), inSize);
+  if (!OpenDecoder())
+    return false;
+  buffer.resize(StreamChunkSize);
+  data = buffer.data();
+  return true;
+}
+
+bool MPSSource::OpenDecoder()
+{
+  switch (codec)
+  {
+  case Codec::Plain:
+    return true;
+  case Codec::Gzip:
+  {
+    auto *stream = new z_stream();
+    decoder = stream;
+    // 窗口位数加 32：自动识别 gzip 与 zlib 头
+    return inflateInit2(stream, 15 + 32) == Z_OK;
+  }
+  case Codec::Bzip2:
+#ifdef HAVE_BZIP2
+  {
+    auto *stream = new bz_stream();
+    decoder = stream;
+    return BZ2_bzDecompressInit(stream, 0, 0) == BZ_OK;
+  }
+#else
+    printf("c bzip2 input is not supported by this build.\n");
+    return false;
+#endif
+  case Codec::Zstd:
+#ifdef HAVE_ZSTD
+    decoder = ZSTD_createDStream();
+    return decoder != nullptr && !ZSTD_isError(ZSTD_initDStream((ZSTD_DStream *)decoder));
+#else
+    printf("c zstd input is not supported by this build.\n");
+    return false;
+#endif
+  }
+  return false;
+}
+
+void MPSSource::CloseDecoder()
+{
+  if (decoder == nullptr)
+    return;
+  if (codec == Codec::Gzip)
+  {
+    inflateEnd((z_stream *)decoder);
+    delete (z_stream *)decoder;
+  }
+#ifdef HAVE_BZIP2
+  else if (codec == Codec::Bzip2)
+  {
+    BZ2_bzDecompressEnd((bz_stream *)decoder);
+    delete (bz_stream *)decoder;
+  }
+#endif
+#ifdef HAVE_ZSTD
+  else if (codec == Codec::Zstd)
+    ZSTD_freeDStream((ZSTD_DStream *)decoder);
+#endif
+  decoder = nullptr;
+}
+
+void MPSSource::Close()
+{
+  if (mapAddr != nullptr)
+    munmap(mapAddr, mapSize);
+  CloseDecoder();
+  if (fd >= 0)
+    close(fd);
+  mapAddr = nullptr;
+  mapSize = 0;
+  fd = -1;
+  codec = Codec::Plain;
+  isStream = false;
+  isEnd = false;
+  byteNum = 0;
+  vector<char>().swap(buffer);
+  vector<char>().swap(inBuffer);
+  inPos = 0;
+  inSize = 0;
+  data = nullptr;
+  size = 0;
+  pos = 0;
+}
+
+// 解压出至多 _capacity 字节，输入耗尽时返回 0；多成员 gzip、多流 bzip2 与多帧 zstd 依次解压
+size_t MPSSource::ReadChunk(
+    char *_dst,
+    size_t _capacity)
+{
+  size_t outNum = 0;
+  while (outNum == 0)
+  {
+    if (inPos == inSize)
+    {
+      ssize_t readNum = read(fd, inBuffer.data(), inBuffer.size());
+      if (readNum <= 0)
+        return 0;
+      inPos = 0;
+      inSize = readNum;
+    }
+    bool isError = false;
+    switch (codec)
+    {
+    case Codec::Plain:
+      outNum = min(_capacity, inSize - inPos);
+      memcpy(_dst, inBuffer.data() + inPos, outNum);
+      inPos += outNum;
+      break;
+    case Codec::Gzip:
+    {
+      auto *stream = (z_stream *)decoder;
+      stream->next_in = reinterpret_cast<Bytef *>(inBuffer.data() + inPos);
+      stream->avail_in = inSize - inPos;
+      stream->next_out = reinterpret_cast<Bytef *>(_dst);
+      stream->avail_out = _capacity;
+      int ret = inflate(stream, Z_NO_FLUSH);
+      inPos = inSize - stream->avail_in;
+      outNum = _capacity - stream->avail_out;
+      if (ret == Z_STREAM_END)
+        inflateReset(stream);
+      else
+        isError = ret != Z_OK && ret != Z_BUF_ERROR;
+      break;
+    }
+#ifdef HAVE_BZIP2
+    case Codec::Bzip2:
+    {
+      auto *stream = (bz_stream *)decoder;
+      stream->next_in = inBuffer.data() + inPos;
+      stream->avail_in = inSize - inPos;
+      stream->next_out = _dst;
+      stream->avail_out = _capacity;
+      int ret = BZ2_bzDecompress(stream);
+      inPos = inSize - stream->avail_in;
+      outNum = _capacity - stream->avail_out;
+      if (ret == BZ_STREAM_END)
+      {
+        BZ2_bzDecompressEnd(stream);
+        isError = BZ2_bzDecompressInit(stream, 0, 0) != BZ_OK;
+      }
+      else
+        isError = ret != BZ_OK;
+      break;
+    }
+#endif
+#ifdef HAVE_ZSTD
+    case Codec::Zstd:
+    {
+      ZSTD_inBuffer in = {inBuffer.data(), inSize, inPos};
+      ZSTD_outBuffer out = {_dst, _capacity, 0};
+      isError = ZSTD_isError(ZSTD_decompressStream((ZSTD_DStream *)decoder, &out, &in));
+      inPos = in.pos;
+      outNum = out.pos;
+      break;
+    }
+#endif
+    default:
+      isError = true;
+    }
+    if (isError)
+    {
+      printf("c error: corrupted %s input.\n", CodecName());
+      exit(-1);
+    }
+  }
+  return outNum;
+}
+
+// 把未结束的行移到缓冲区开头，再接着解压一块；单行超过缓冲区时扩容
+bool MPSSource::Refill()
+{
+  if (isEnd)
+    return false;
+  size_t restNum = size - pos;
+  memmove(buffer.data(), buffer.data() + pos, restNum);
+  pos = 0;
+  size = restNum;
+  if (size == buffer.size())
+    buffer.resize(buffer.size() * 2);
+  data = buffer.data();
+  size_t readNum = ReadChunk(buffer.data() + size, buffer.size() - size);
+  if (readNum == 0)
+    isEnd = true;
+  size += readNum;
+  byteNum += readNum;
+  return readNum > 0;
+}
+
+// 与 getline 一致：行不含换行符，末行可以没有换行符
+bool MPSSource::NextLine(
+    std::string_view &_line)
+{
+  while (true)
+  {
+    const char *begin = data + pos;
+    const char *lineEnd =
+        pos < size ? static_cast<const char *>(memchr(begin, '\n', size - pos)) : nullptr;
+    if (lineEnd != nullptr)
+    {
+      _line = std::string_view(begin, lineEnd - begin);
+      pos = lineEnd - data + 1;
+      return true;
+    }
+    if (!isStream || !Refill())
+    {
+      if (pos >= size)
+        return false;
+      _line = std::string_view(data + pos, size - pos);
+      pos = size;
+      return true;
+    }
+  }
+}
+
+// 解压后的字节数
+size_t MPSSource::ByteNum() const
+{
+  return byteNum;
+}
+
+const char *MPSSource::CodecName() const
+{
+  switch (codec)
+  {
+  case Codec::Gzip:
+    return "gzip";
+  case Codec::Bzip2:
+    return "bzip2";
+  case Codec::Zstd:
+    return "zstd";
+  default:
+    return isStream ? "stream" : "mmap";
+  }
+}
@@ -0,0 +1,169 @@
+/*=====================================================================================
+
+    Filename:     MPSSource.h
+
+    Description:  Zero-copy line and token access to MPS files
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#pragma once
+#include "utils/paras.h"
+#include <charconv>
+#include <string_view>
+
+// 输入的压缩格式，按文件头的魔数识别
+enum class Codec
+{
+  Plain,
+  Gzip,
+  Bzip2,
+  Zstd
+};
+
+// 普通文件整体 mmap，返回的行是映射区上的视图；
+// 压缩文件与无法映射的输入（如管道）按块流式解压到定长缓冲区，行在下次调用 NextLine 前有效
+class MPSSource
+{
+private:
+  const char *data;
+  size_t size;
+  size_t pos;
+  void *mapAddr;
+  size_t mapSize;
+  int fd;
+  Codec codec;
+  bool isStream;
+  bool isEnd;
+  size_t byteNum;
+  vector<char> buffer;
+  void *decoder;
+  vector<char> inBuffer;
+  size_t inPos;
+  size_t inSize;
+  bool OpenDecoder();
+  void CloseDecoder();
+  size_t ReadChunk(
+      char *_dst,
+      size_t _capacity);
+  bool Refill();
+
+public:
+  MPSSource();
+  ~MPSSource();
+  bool Open(
+      const char *_fileName);
+  void Close();
+  bool NextLine(
+      std::string_view &_line);
+  size_t ByteNum() const;
+  const char *CodecName() const;
+};
+
+// 一行内的记号游标，空白与失败语义同 istream 的 operator>>：
+// 某次读取失败后，本行后续读取全部失败
+class MPSLine
+{
+private:
+  const char *cur;
+  const char *end;
+
+  static bool IsSpace(
+      char _c)
+  {
+    return _c == ' ' || _c == '\t' || _c == '\r' || _c == '\n' || _c == '\v' || _c == '\f';
+  }
+
+  void SkipSpace()
+  {
+    while (cur < end && IsSpace(*cur))
+      ++cur;
+  }
+
+  bool Fail()
+  {
+    cur = end;
+    return false;
+  }
+
+public:
+  void Reset(
+      std::string_view _line)
+  {
+    cur = _line.data();
+    end = _line.data() + _line.size();
+  }
+
+  bool NextToken(
+      std::string_view &_token)
+  {
+    SkipSpace();
+    if (cur == end)
+      return Fail();
+    const char *begin = cur;
+    while (cur < end && !IsSpace(*cur))
+      ++cur;
+    _token = std::string_view(begin, cur - begin);
+    return true;
+  }
+
+  // 复用 _token 已有的容量，稳态下不分配内存
+  bool NextToken(
+      string &_token)
+  {
+    std::string_view token;
+    if (!NextToken(token))
+      return false;
+    _token.assign(token.data(), token.size());
+    return true;
+  }
+
+  // 剩余记号数，不移动游标
+  size_t TokenNum() const
+  {
+    size_t tokenNum = 0;
+    for (const char *scan = cur; scan < end; ++tokenNum)
+    {
+      while (scan < end && IsSpace(*scan))
+        ++scan;
+      if (scan == end)
+        break;
+      while (scan < end && !IsSpace(*scan))
+        ++scan;
+    }
+    return tokenNum;
+  }
+
+  bool NextChar(
+      char &_c)
+  {
+    SkipSpace();
+    if (cur == end)
+      return Fail();
+    _c = *cur++;
+    return true;
+  }
+
+  bool NextValue(
+      Value &_value)
+  {
+    SkipSpace();
+    if (cur < end && *cur == '+')
+      ++cur;
+    auto result = std::from_chars(cur, end, _value);
+    if (result.ec != std::errc())
+    {
+      _value = 0;
+      return Fail();
+    }
+    cur = result.ptr;
+    return true;
+  }
+};
@@ -15,6 +15,7 @@
 =====================================================================================*/
 
 #include "ModelCon.h"
+#include "ModelVar.h"
 
 ModelCon::ModelCon(
     const string &_name,
@@ -23,7 +24,11 @@ ModelCon::ModelCon(
       isEqual(false),
       isLarge(false),
       idx(_idx),
+      coeffSet(nullptr),
+      varIdxSet(nullptr),
+      posInVar(nullptr),
       RHS(0),
+      lowerRHS(NegativeInfinity),
       inferSAT(false),
       termNum(-1)
 {
@@ -31,19 +36,21 @@ ModelCon::ModelCon(
 
 ModelCon::~ModelCon()
 {
-  coeffSet.clear();
-  varIdxSet.clear();
-  posInVar.clear();
 }
 
 ModelConUtil::ModelConUtil()
-    : conNum(-1)
+    : conNum(-1),
+      isIntegral(false)
 {
 }
 
 ModelConUtil::~ModelConUtil()
 {
   conSet.clear();
+  termBegin.clear();
+  termVarIdxs.clear();
+  termCoeffs.clear();
+  termPosInVar.clear();
   name2idx.clear();
 }
 
@@ -87,3 +94,49 @@ ModelCon &ModelConUtil::GetCon(
     return conSet[0];
   return conSet[name2idx[_name]];
 }
+
+void ModelConUtil::LinkTerms()
+{
+  for (size_t conIdx = 0; conIdx < conSet.size(); ++conIdx)
+  {
+    auto &con = conSet[conIdx];
+    size_t begin = termBegin[conIdx];
+    con.coeffSet = termCoeffs.data() + begin;
+    con.varIdxSet = termVarIdxs.data() + begin;
+    con.posInVar = termPosInVar.data() + begin;
+    con.termNum = termBegin[conIdx + 1] - begin;
+  }
+}
+
+void ModelConUtil::DetectIntegral(
+    const ModelVarUtil &_modelVarUtil)
+{
+  const Value exactLimit = 9007199254740992.0; // 2^53
+  auto isIntegralValue = [](Value _value)
+  { return _value == floor(_value); };
+  isIntegral = false;
+  for (const auto &modelVar : _modelVarUtil.varSet)
+    if (modelVar.termNum > 0 &&
+        (modelVar.type == VarType::Real ||
+         !isIntegralValue(modelVar.lowerBound) || !isIntegralValue(modelVar.upperBound)))
+      return;
+  for (const auto &modelCon : conSet)
+  {
+    if (modelCon.idx > 0 &&
+        (!isIntegralValue(modelCon.RHS) ||
+         (modelCon.lowerRHS != NegativeInfinity && !isIntegralValue(modelCon.lowerRHS))))
+      return;
+    Value maxActivity = 0;
+    for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+    {
+      Value coeff = modelCon.coeffSet[termIdx];
+      const auto &modelVar = _modelVarUtil.GetVar(modelCon.varIdxSet[termIdx]);
+      if (!isIntegralValue(coeff))
+        return;
+      maxActivity += fabs(coeff) * max(fabs(modelVar.lowerBound), fabs(modelVar.upperBound));
+    }
+    if (maxActivity >= exactLimit)
+      return;
+  }
+  isIntegral = true;
+}
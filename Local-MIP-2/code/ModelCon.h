@@ -17,6 +17,8 @@
 #pragma once
 #include "utils/paras.h"
 
+class ModelVarUtil;
+
 class ModelCon
 {
 public:
@@ -24,10 +26,11 @@ public:
   size_t idx;
   bool isEqual;
   bool isLarge;
-  vector<Value> coeffSet;
-  vector<size_t> varIdxSet;
-  vector<size_t> posInVar;
+  const Value *coeffSet;
+  const Index *varIdxSet;
+  const Index *posInVar;
   Value RHS;
+  Value lowerRHS; // 区间约束 lowerRHS <= a·x <= RHS 的下界，单侧约束为负无穷
   bool inferSAT;
   size_t termNum;
 
@@ -42,9 +45,16 @@ class ModelConUtil
 public:
   unordered_map<string, size_t> name2idx;
   vector<ModelCon> conSet;
+  vector<size_t> termBegin;
+  vector<Index> termVarIdxs;
+  vector<Value> termCoeffs;
+  vector<Index> termPosInVar;
   string objName;
   size_t conNum;
   int MIN = 1;
+  // 整数模型：变量均为整数，系数、约束两侧均为整数且每行活动度不超过 2^53，
+  // 双精度下 LHS 的增量更新是精确的整数运算，不会漂移
+  bool isIntegral;
 
   ModelConUtil();
   ~ModelConUtil();
@@ -58,4 +68,7 @@ public:
       const size_t _idx);
   ModelCon &GetCon(
       const string &_name);
+  void LinkTerms();
+  void DetectIntegral(
+      const ModelVarUtil &_modelVarUtil);
 };
\ No newline at end of file
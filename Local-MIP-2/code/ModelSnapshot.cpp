@@ -0,0 +1,364 @@
+/*=====================================================================================
+
+    Filename:     ModelSnapshot.cpp
+
+    Description:  Binary snapshot of the preprocessed model
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "ModelSnapshot.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char SnapshotMagic[8] = {'L', 'M', 'I', 'P', 'S', 'N', 'A', 'P'};
+static const uint32_t SnapshotVersion = 3;
+static const uint32_t SnapshotByteOrder = 0x01020304;
+
+static uint64_t AlignSection(
+    uint64_t _offset)
+{
+  return (_offset + 7) & ~(uint64_t)7;
+}
+
+ModelSnapshot::ModelSnapshot()
+    : mapAddr(nullptr),
+      mapSize(0)
+{
+}
+
+ModelSnapshot::~ModelSnapshot()
+{
+  if (mapAddr != nullptr)
+    munmap(mapAddr, mapSize);
+}
+
+// 从约束与变量的项指针写出，因此由快照载入的模型也可以再次保存
+bool ModelSnapshot::Save(
+    const char *_fileName,
+    const ModelConUtil *_modelConUtil,
+    const ModelVarUtil *_modelVarUtil,
+    bool _isSaveName)
+{
+  size_t conNum = _modelConUtil->conNum;
+  size_t varNum = _modelVarUtil->varNum;
+  size_t termNum = 0;
+  for (const auto &modelCon : _modelConUtil->conSet)
+    termNum += modelCon.termNum;
+  const auto &postsolve = _modelVarUtil->postsolve;
+  size_t postsolveNum = postsolve.StepNum();
+  size_t postsolveTermNum = postsolve.termVarIdxs.size();
+  size_t nameNum = 1 + conNum + varNum;
+  size_t nameCharNum = 0;
+  if (_isSaveName)
+  {
+    nameCharNum += _modelConUtil->objName.size();
+    for (const auto &modelCon : _modelConUtil->conSet)
+      nameCharNum += modelCon.name.size();
+    for (const auto &modelVar : _modelVarUtil->varSet)
+      nameCharNum += modelVar.name.size();
+  }
+
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SnapshotMagic, sizeof(SnapshotMagic));
+  header.version = SnapshotVersion;
+  header.byteOrder = SnapshotByteOrder;
+  header.valueSize = sizeof(Value);
+  header.indexSize = sizeof(Index);
+  header.conNum = conNum;
+  header.varNum = varNum;
+  header.termNum = termNum;
+  header.MIN = _modelConUtil->MIN;
+  header.objBias = _modelVarUtil->objBias;
+  header.integerNum = _modelVarUtil->integerNum;
+  header.binaryNum = _modelVarUtil->binaryNum;
+  header.fixedNum = _modelVarUtil->fixedNum;
+  header.realNum = _modelVarUtil->realNum;
+  header.isBin = _modelVarUtil->isBin;
+  header.hasNames = _isSaveName;
+  header.postsolveNum = postsolveNum;
+  header.postsolveTermNum = postsolveTermNum;
+  uint64_t sectionSize[SectionNum] = {
+      conNum * sizeof(Value),
+      conNum * sizeof(Value),
+      conNum,
+      (conNum + 1) * sizeof(size_t),
+      termNum * sizeof(Index),
+      termNum * sizeof(Value),
+      termNum * sizeof(Index),
+      varNum * sizeof(Value),
+      varNum * sizeof(Value),
+      varNum,
+      (varNum + 1) * sizeof(size_t),
+      termNum * sizeof(Index),
+      termNum * sizeof(Value),
+      termNum * sizeof(Index),
+      varNum * sizeof(size_t),
+      postsolveNum * sizeof(size_t),
+      5 * postsolveNum * sizeof(Value),
+      (postsolveNum + 1) * sizeof(size_t),
+      postsolveTermNum * sizeof(size_t),
+      postsolveTermNum * sizeof(Value),
+      _isSaveName ? (nameNum + 1) * sizeof(size_t) : 0,
+      nameCharNum};
+  uint64_t offset = AlignSection(sizeof(header));
+  for (size_t section = 0; section < SectionNum; ++section)
+  {
+    header.sectionOffset[section] = offset;
+    offset = AlignSection(offset + sectionSize[section]);
+  }
+  header.fileSize = offset;
+
+  FILE *fp = fopen(_fileName, "wb");
+  if (fp == nullptr)
+    return false;
+  uint64_t written = 0;
+  auto put = [&](const void *_data, size_t _bytes)
+  {
+    fwrite(_data, 1, _bytes, fp);
+    written += _bytes;
+  };
+  auto pad = [&]()
+  {
+    static const char zeros[8] = {0};
+    put(zeros, AlignSection(written) - written);
+  };
+  put(&header, sizeof(header));
+  pad();
+
+  const auto &conSet = _modelConUtil->conSet;
+  for (const auto &modelCon : conSet)
+    put(&modelCon.RHS, sizeof(Value));
+  for (const auto &modelCon : conSet)
+    put(&modelCon.lowerRHS, sizeof(Value));
+  pad();
+  for (const auto &modelCon : conSet)
+  {
+    uint8_t flag = modelCon.isEqual | modelCon.isLarge << 1 | modelCon.inferSAT << 2;
+    put(&flag, 1);
+  }
+  pad();
+  size_t termBegin = 0;
+  put(&termBegin, sizeof(size_t));
+  for (const auto &modelCon : conSet)
+  {
+    termBegin += modelCon.termNum;
+    put(&termBegin, sizeof(size_t));
+  }
+  for (const auto &modelCon : conSet)
+    put(modelCon.varIdxSet, modelCon.termNum * sizeof(Index));
+  pad();
+  for (const auto &modelCon : conSet)
+    put(modelCon.coeffSet, modelCon.termNum * sizeof(Value));
+  pad();
+  for (const auto &modelCon : conSet)
+    put(modelCon.posInVar, modelCon.termNum * sizeof(Index));
+  pad();
+
+  const auto &varSet = _modelVarUtil->varSet;
+  for (const auto &modelVar : varSet)
+    put(&modelVar.lowerBound, sizeof(Value));
+  for (const auto &modelVar : varSet)
+    put(&modelVar.upperBound, sizeof(Value));
+  for (const auto &modelVar : varSet)
+  {
+    uint8_t type = (uint8_t)modelVar.type;
+    put(&type, 1);
+  }
+  pad();
+  termBegin = 0;
+  put(&termBegin, sizeof(size_t));
+  for (const auto &modelVar : varSet)
+  {
+    termBegin += modelVar.termNum;
+    put(&termBegin, sizeof(size_t));
+  }
+  for (const auto &modelVar : varSet)
+    put(modelVar.conIdxSet, modelVar.termNum * sizeof(Index));
+  pad();
+  for (const auto &modelVar : varSet)
+    put(modelVar.coeffSet, modelVar.termNum * sizeof(Value));
+  pad();
+  for (const auto &modelVar : varSet)
+    put(modelVar.posInCon, modelVar.termNum * sizeof(Index));
+  pad();
+  put(_modelVarUtil->varIdx2ObjIdx.data(), varNum * sizeof(size_t));
+  pad();
+
+  // 后处理栈：每步的五个数值按数组依次存放
+  put(postsolve.varIdxs.data(), postsolveNum * sizeof(size_t));
+  pad();
+  put(postsolve.pivotCoeffs.data(), postsolveNum * sizeof(Value));
+  put(postsolve.lowerSides.data(), postsolveNum * sizeof(Value));
+  put(postsolve.upperSides.data(), postsolveNum * sizeof(Value));
+  put(postsolve.lowerBounds.data(), postsolveNum * sizeof(Value));
+  put(postsolve.upperBounds.data(), postsolveNum * sizeof(Value));
+  pad();
+  put(postsolve.termBegin.data(), (postsolveNum + 1) * sizeof(size_t));
+  pad();
+  put(postsolve.termVarIdxs.data(), postsolveTermNum * sizeof(size_t));
+  pad();
+  put(postsolve.termCoeffs.data(), postsolveTermNum * sizeof(Value));
+  pad();
+
+  // 名称段：目标函数名、各约束名、各变量名依次拼接
+  if (_isSaveName)
+  {
+    size_t nameBegin = 0;
+    put(&nameBegin, sizeof(size_t));
+    nameBegin += _modelConUtil->objName.size();
+    put(&nameBegin, sizeof(size_t));
+    for (const auto &modelCon : conSet)
+    {
+      nameBegin += modelCon.name.size();
+      put(&nameBegin, sizeof(size_t));
+    }
+    for (const auto &modelVar : varSet)
+    {
+      nameBegin += modelVar.name.size();
+      put(&nameBegin, sizeof(size_t));
+    }
+    put(_modelConUtil->objName.data(), _modelConUtil->objName.size());
+    for (const auto &modelCon : conSet)
+      put(modelCon.name.data(), modelCon.name.size());
+    for (const auto &modelVar : varSet)
+      put(modelVar.name.data(), modelVar.name.size());
+  }
+  pad();
+  bool isWritten = !ferror(fp) && written == header.fileSize;
+  return fclose(fp) == 0 && isWritten;
+}
+
+// 映射在本对象析构前一直有效；没有名称段时按下标生成名称
+bool ModelSnapshot::Load(
+    const char *_fileName,
+    ModelConUtil *_modelConUtil,
+    ModelVarUtil *_modelVarUtil)
+{
+  int fd = open(_fileName, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < sizeof(SnapshotHeader))
+  {
+    close(fd);
+    return false;
+  }
+  void *addr = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+  mapAddr = addr;
+  mapSize = fileStat.st_size;
+
+  const char *base = static_cast<const char *>(addr);
+  const auto &header = *reinterpret_cast<const SnapshotHeader *>(base);
+  if (memcmp(header.magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0 ||
+      header.version != SnapshotVersion ||
+      header.byteOrder != SnapshotByteOrder ||
+      header.valueSize != sizeof(Value) ||
+      header.indexSize != sizeof(Index) ||
+      header.fileSize != mapSize)
+    return false;
+  for (size_t section = 0; section < SectionNum; ++section)
+    if (header.sectionOffset[section] > mapSize)
+      return false;
+  auto sectionOf = [&](SnapshotSection _section)
+  { return base + header.sectionOffset[_section]; };
+  size_t conNum = header.conNum;
+  size_t varNum = header.varNum;
+  auto conRHS = reinterpret_cast<const Value *>(sectionOf(SectionConRHS));
+  auto conLowerRHS = reinterpret_cast<const Value *>(sectionOf(SectionConLowerRHS));
+  auto conFlag = reinterpret_cast<const uint8_t *>(sectionOf(SectionConFlag));
+  auto conTermBegin = reinterpret_cast<const size_t *>(sectionOf(SectionConTermBegin));
+  auto conVarIdx = reinterpret_cast<const Index *>(sectionOf(SectionConVarIdx));
+  auto conCoeff = reinterpret_cast<const Value *>(sectionOf(SectionConCoeff));
+  auto conPosInVar = reinterpret_cast<const Index *>(sectionOf(SectionConPosInVar));
+  auto varLower = reinterpret_cast<const Value *>(sectionOf(SectionVarLower));
+  auto varUpper = reinterpret_cast<const Value *>(sectionOf(SectionVarUpper));
+  auto varType = reinterpret_cast<const uint8_t *>(sectionOf(SectionVarType));
+  auto varTermBegin = reinterpret_cast<const size_t *>(sectionOf(SectionVarTermBegin));
+  auto varConIdx = reinterpret_cast<const Index *>(sectionOf(SectionVarConIdx));
+  auto varCoeff = reinterpret_cast<const Value *>(sectionOf(SectionVarCoeff));
+  auto varPosInCon = reinterpret_cast<const Index *>(sectionOf(SectionVarPosInCon));
+  auto varObjIdx = reinterpret_cast<const size_t *>(sectionOf(SectionVarObjIdx));
+  auto nameBegin = reinterpret_cast<const size_t *>(sectionOf(SectionNameBegin));
+  auto nameChar = sectionOf(SectionNameChar);
+  auto nameOf = [&](size_t _nameIdx)
+  { return string(nameChar + nameBegin[_nameIdx], nameBegin[_nameIdx + 1] - nameBegin[_nameIdx]); };
+
+  _modelConUtil->MIN = header.MIN;
+  _modelConUtil->conNum = conNum;
+  _modelConUtil->objName = header.hasNames ? nameOf(0) : "obj";
+  _modelConUtil->conSet.reserve(conNum);
+  for (size_t conIdx = 0; conIdx < conNum; ++conIdx)
+  {
+    _modelConUtil->conSet.emplace_back(
+        header.hasNames ? nameOf(1 + conIdx) : conIdx == 0 ? "" : "c" + to_string(conIdx),
+        conIdx);
+    auto &modelCon = _modelConUtil->conSet.back();
+    modelCon.RHS = conRHS[conIdx];
+    modelCon.lowerRHS = conLowerRHS[conIdx];
+    modelCon.isEqual = conFlag[conIdx] & 1;
+    modelCon.isLarge = conFlag[conIdx] & 2;
+    modelCon.inferSAT = conFlag[conIdx] & 4;
+    modelCon.varIdxSet = conVarIdx + conTermBegin[conIdx];
+    modelCon.coeffSet = conCoeff + conTermBegin[conIdx];
+    modelCon.posInVar = conPosInVar + conTermBegin[conIdx];
+    modelCon.termNum = conTermBegin[conIdx + 1] - conTermBegin[conIdx];
+  }
+
+  _modelVarUtil->varNum = varNum;
+  _modelVarUtil->integerNum = header.integerNum;
+  _modelVarUtil->binaryNum = header.binaryNum;
+  _modelVarUtil->fixedNum = header.fixedNum;
+  _modelVarUtil->realNum = header.realNum;
+  _modelVarUtil->isBin = header.isBin;
+  _modelVarUtil->objBias = header.objBias;
+  _modelVarUtil->varSet.reserve(varNum);
+  for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+  {
+    _modelVarUtil->varSet.emplace_back(
+        header.hasNames ? nameOf(1 + conNum + varIdx) : "x" + to_string(varIdx),
+        varIdx, false);
+    auto &modelVar = _modelVarUtil->varSet.back();
+    modelVar.lowerBound = varLower[varIdx];
+    modelVar.upperBound = varUpper[varIdx];
+    modelVar.type = (VarType)varType[varIdx];
+    modelVar.conIdxSet = varConIdx + varTermBegin[varIdx];
+    modelVar.coeffSet = varCoeff + varTermBegin[varIdx];
+    modelVar.posInCon = varPosInCon + varTermBegin[varIdx];
+    modelVar.termNum = varTermBegin[varIdx + 1] - varTermBegin[varIdx];
+  }
+  _modelVarUtil->varIdx2ObjIdx.assign(varObjIdx, varObjIdx + varNum);
+
+  size_t postsolveNum = header.postsolveNum;
+  size_t postsolveTermNum = header.postsolveTermNum;
+  auto postVarIdx = reinterpret_cast<const size_t *>(sectionOf(SectionPostVarIdx));
+  auto postValue = reinterpret_cast<const Value *>(sectionOf(SectionPostValue));
+  auto postTermBegin = reinterpret_cast<const size_t *>(sectionOf(SectionPostTermBegin));
+  auto postTermVarIdx = reinterpret_cast<const size_t *>(sectionOf(SectionPostTermVarIdx));
+  auto postTermCoeff = reinterpret_cast<const Value *>(sectionOf(SectionPostTermCoeff));
+  auto &postsolve = _modelVarUtil->postsolve;
+  postsolve.varIdxs.assign(postVarIdx, postVarIdx + postsolveNum);
+  postsolve.pivotCoeffs.assign(postValue, postValue + postsolveNum);
+  postsolve.lowerSides.assign(postValue + postsolveNum, postValue + 2 * postsolveNum);
+  postsolve.upperSides.assign(postValue + 2 * postsolveNum, postValue + 3 * postsolveNum);
+  postsolve.lowerBounds.assign(postValue + 3 * postsolveNum, postValue + 4 * postsolveNum);
+  postsolve.upperBounds.assign(postValue + 4 * postsolveNum, postValue + 5 * postsolveNum);
+  postsolve.termBegin.assign(postTermBegin, postTermBegin + postsolveNum + 1);
+  postsolve.termVarIdxs.assign(postTermVarIdx, postTermVarIdx + postsolveTermNum);
+  postsolve.termCoeffs.assign(postTermCoeff, postTermCoeff + postsolveTermNum);
+  return true;
+}
@@ -0,0 +1,94 @@
+/*=====================================================================================
+
+    Filename:     ModelSnapshot.h
+
+    Description:  Binary snapshot of the preprocessed model
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#pragma once
+#include "utils/paras.h"
+#include "ModelCon.h"
+#include "ModelVar.h"
+
+// 快照各段在文件中的顺序
+enum SnapshotSection
+{
+  SectionConRHS,
+  SectionConLowerRHS,
+  SectionConFlag,
+  SectionConTermBegin,
+  SectionConVarIdx,
+  SectionConCoeff,
+  SectionConPosInVar,
+  SectionVarLower,
+  SectionVarUpper,
+  SectionVarType,
+  SectionVarTermBegin,
+  SectionVarConIdx,
+  SectionVarCoeff,
+  SectionVarPosInCon,
+  SectionVarObjIdx,
+  SectionPostVarIdx,
+  SectionPostValue,
+  SectionPostTermBegin,
+  SectionPostTermVarIdx,
+  SectionPostTermCoeff,
+  SectionNameBegin,
+  SectionNameChar,
+  SectionNum
+};
+
+// 文件头之后依次是各段，每段按 8 字节对齐；数组按本机字节序与位宽原样存储，
+// 载入时整体 mmap，约束与变量的项指针直接指向映射区，多个进程可共享同一份页缓存
+struct SnapshotHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint32_t valueSize;
+  uint32_t indexSize;
+  uint64_t conNum;
+  uint64_t varNum;
+  uint64_t termNum;
+  int64_t MIN;
+  double objBias;
+  uint64_t integerNum;
+  uint64_t binaryNum;
+  uint64_t fixedNum;
+  uint64_t realNum;
+  uint64_t isBin;
+  uint64_t hasNames;
+  uint64_t postsolveNum;
+  uint64_t postsolveTermNum;
+  uint64_t sectionOffset[SectionNum];
+  uint64_t fileSize;
+};
+
+class ModelSnapshot
+{
+private:
+  void *mapAddr;
+  size_t mapSize;
+
+public:
+  ModelSnapshot();
+  ~ModelSnapshot();
+  static bool Save(
+      const char *_fileName,
+      const ModelConUtil *_modelConUtil,
+      const ModelVarUtil *_modelVarUtil,
+      bool _isSaveName);
+  bool Load(
+      const char *_fileName,
+      ModelConUtil *_modelConUtil,
+      ModelVarUtil *_modelVarUtil);
+};
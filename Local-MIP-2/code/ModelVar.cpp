@@ -24,6 +24,9 @@ ModelVar::ModelVar(
       idx(_idx),
       upperBound(DefaultRealUpperBound),
       lowerBound(DefaultLowerBound),
+      conIdxSet(nullptr),
+      posInCon(nullptr),
+      coeffSet(nullptr),
       termNum(-1),
       type(VarType::Real)
 {
@@ -37,8 +40,6 @@ ModelVar::ModelVar(
 
 ModelVar::~ModelVar()
 {
-  conIdxSet.clear();
-  posInCon.clear();
 }
 
 bool ModelVar::InBound(
@@ -100,6 +101,10 @@ ModelVarUtil::~ModelVarUtil()
   varIdx2ObjIdx.clear();
   name2idx.clear();
   varSet.clear();
+  termBegin.clear();
+  termConIdxs.clear();
+  termCoeffs.clear();
+  termPosInCon.clear();
 }
 
 size_t ModelVarUtil::MakeVar(
@@ -133,4 +138,17 @@ ModelVar &ModelVarUtil::GetVar(
     const string &_name)
 {
   return varSet[name2idx[_name]];
-}
\ No newline at end of file
+}
+
+void ModelVarUtil::LinkTerms()
+{
+  for (size_t varIdx = 0; varIdx < varSet.size(); ++varIdx)
+  {
+    auto &var = varSet[varIdx];
+    size_t begin = termBegin[varIdx];
+    var.conIdxSet = termConIdxs.data() + begin;
+    var.posInCon = termPosInCon.data() + begin;
+    var.coeffSet = termCoeffs.data() + begin;
+    var.termNum = termBegin[varIdx + 1] - begin;
+  }
+}
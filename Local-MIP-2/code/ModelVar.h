@@ -16,6 +16,7 @@
 
 #pragma once
 #include "utils/paras.h"
+#include "Postsolve.h"
 
 class ModelVar
 {
@@ -24,8 +25,9 @@ public:
 	size_t idx;
 	Value upperBound;
 	Value lowerBound;
-	vector<size_t> conIdxSet;
-	vector<size_t> posInCon;
+	const Index *conIdxSet;
+	const Index *posInCon;
+	const Value *coeffSet;
 	size_t termNum;
 	VarType type;
 
@@ -51,6 +53,10 @@ class ModelVarUtil
 public:
 	unordered_map<string, size_t> name2idx;
 	vector<ModelVar> varSet;
+	vector<size_t> termBegin;
+	vector<Index> termConIdxs;
+	vector<Value> termCoeffs;
+	vector<Index> termPosInCon;
 	vector<size_t> varIdx2ObjIdx;
 	bool isBin;
 	size_t varNum;
@@ -59,6 +65,7 @@ public:
 	size_t fixedNum;
 	size_t realNum;
 	Value objBias;
+	PostsolveStack postsolve;
 
 	ModelVarUtil();
 	~ModelVarUtil();
@@ -71,4 +78,5 @@ public:
 			const size_t _idx);
 	ModelVar &GetVar(
 			const string &_name);
+	void LinkTerms();
 };
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*=====================================================================================
+
+    Filename:     Postsolve.cpp
+
+    Description:  Recovery of columns eliminated in presolve
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#include "Postsolve.h"
+
+PostsolveStack::PostsolveStack()
+    : termBegin(1, 0)
+{
+}
+
+PostsolveStack::~PostsolveStack()
+{
+}
+
+size_t PostsolveStack::StepNum() const
+{
+  return varIdxs.size();
+}
+
+// 约束的其余项随后用 PushTerm 依次追加
+void PostsolveStack::Push(
+    size_t _varIdx,
+    Value _pivotCoeff,
+    Value _lowerSide,
+    Value _upperSide,
+    Value _lowerBound,
+    Value _upperBound)
+{
+  varIdxs.push_back(_varIdx);
+  pivotCoeffs.push_back(_pivotCoeff);
+  lowerSides.push_back(_lowerSide);
+  upperSides.push_back(_upperSide);
+  lowerBounds.push_back(_lowerBound);
+  upperBounds.push_back(_upperBound);
+  termBegin.push_back(termBegin.back());
+}
+
+void PostsolveStack::PushTerm(
+    size_t _varIdx,
+    Value _coeff)
+{
+  termVarIdxs.push_back(_varIdx);
+  termCoeffs.push_back(_coeff);
+  ++termBegin.back();
+}
+
+// 被消去变量取约束允许区间与原始界的交集中最接近 0 的值；
+// 带目标系数的变量在消去时已把约束两侧定为同一值，解唯一
+void PostsolveStack::Apply(
+    vector<Value> &_values) const
+{
+  for (size_t step = StepNum(); step-- > 0;)
+  {
+    Value restLHS = 0;
+    for (size_t pos = termBegin[step]; pos < termBegin[step + 1]; ++pos)
+      restLHS += termCoeffs[pos] * _values[termVarIdxs[pos]];
+    Value pivotCoeff = pivotCoeffs[step];
+    Value lower = NegativeInfinity;
+    Value upper = Infinity;
+    if (lowerSides[step] != NegativeInfinity)
+      (pivotCoeff > 0 ? lower : upper) = (lowerSides[step] - restLHS) / pivotCoeff;
+    if (upperSides[step] != Infinity)
+      (pivotCoeff > 0 ? upper : lower) = (upperSides[step] - restLHS) / pivotCoeff;
+    Value boundLower = max(lower, lowerBounds[step]);
+    Value boundUpper = min(upper, upperBounds[step]);
+    if (boundLower <= boundUpper)
+    {
+      lower = boundLower;
+      upper = boundUpper;
+    }
+    _values[varIdxs[step]] = min(max((Value)0, lower), upper);
+  }
+}
@@ -0,0 +1,50 @@
+/*=====================================================================================
+
+    Filename:     Postsolve.h
+
+    Description:  Recovery of columns eliminated in presolve
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#pragma once
+#include "utils/paras.h"
+
+// 预处理消去的列按消去顺序入栈：每步记录被消去变量、它所在约束的两侧与其余项以及原始界；
+// 搜索结束后按逆序由约束解出被消去变量的取值
+class PostsolveStack
+{
+public:
+  vector<size_t> varIdxs;
+  vector<Value> lowerSides;
+  vector<Value> upperSides;
+  vector<Value> lowerBounds;
+  vector<Value> upperBounds;
+  vector<Value> pivotCoeffs;
+  vector<size_t> termBegin;
+  vector<size_t> termVarIdxs;
+  vector<Value> termCoeffs;
+
+  PostsolveStack();
+  ~PostsolveStack();
+  size_t StepNum() const;
+  void Push(
+      size_t _varIdx,
+      Value _pivotCoeff,
+      Value _lowerSide,
+      Value _upperSide,
+      Value _lowerBound,
+      Value _upperBound);
+  void PushTerm(
+      size_t _varIdx,
+      Value _coeff);
+  void Apply(
+      vector<Value> &_values) const;
+};
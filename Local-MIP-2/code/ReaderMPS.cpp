@@ -15,13 +15,27 @@
 =====================================================================================*/
 
 #include "ReaderMPS.h"
+#include <deque>
+
+static const Value RedundantTol = 1e-9; // 判定冗余与平行约束的相对容差
+static const Value PivotTol = 1e-3;     // 消去单元素列时主元相对于行内最大系数的下限
 
 ReaderMPS::ReaderMPS(
     ModelConUtil *_modelConUtil,
     ModelVarUtil *_modelVarUtil)
     : modelConUtil(_modelConUtil),
       modelVarUtil(_modelVarUtil),
-      integralityMarker(false)
+      integralityMarker(false),
+      lastVarIdx(std::numeric_limits<size_t>::max()),
+      deleteConNum(0),
+      deleteVarNum(0),
+      inferVarNum(0),
+      propagateBoundNum(0),
+      redundantConNum(0),
+      parallelConNum(0),
+      dominatedVarNum(0),
+      singletonVarNum(0),
+      isObjChanged(false)
 {
 }
 
@@ -32,78 +46,76 @@ ReaderMPS::~ReaderMPS()
 void ReaderMPS::Read(
     const char *_filename)
 {
-  ifstream infile(_filename);
   string modelName;
-  string tempStr;
+  std::string_view tempStr;
   char conType;
   string conName;
-  string inverseConName;
-  size_t inverseConIdx;
   size_t conIdx;
   string varName;
   Value coefficient;
   Value rhs;
+  Value range;
   string varType;
   Value inputBound;
-  if (!infile)
+  auto clkParse = TimeNow();
+  if (!source.Open(_filename))
   {
     printf("o The input filename %s is invalid.\n", _filename);
     exit(-1);
   }
-  while (getline(infile, readLine)) // NAME section
+  while (source.NextLine(readLine)) // NAME section
   {
-    if (readLine[0] == '*' ||
-        readLine.length() < 1)
+    if (readLine.length() < 1 ||
+        readLine[0] == '*')
       continue;
     if (readLine[0] == 'R' || readLine[0] == 'O')
       break;
-    IssSetup();
-    if (!(iss >> tempStr >> modelName))
+    LineSetup();
+    if (!(line.NextToken(tempStr) && line.NextToken(modelName)))
       continue;
     if (tempStr != "NAME")
       PrintfError(readLine);
     printf("c Model name: %s\n", modelName.c_str());
   }
-  if (readLine[0] == 'O')
+  if (!readLine.empty() && readLine[0] == 'O')
   {
     if (readLine.find("MAX") != string::npos)
       modelConUtil->MIN = -1;
-    while (getline(infile, readLine))
+    while (source.NextLine(readLine))
     {
-      if (readLine[0] == '*' || readLine.length() < 1)
+      if (readLine.length() < 1 || readLine[0] == '*')
         continue;
       if (readLine[0] == 'R')
         break;
-      IssSetup();
-      iss >> tempStr;
+      LineSetup();
+      line.NextToken(tempStr);
       cout << tempStr << endl;
       if (tempStr == "MAX")
         modelConUtil->MIN = -1;
     }
   }
   modelConUtil->conSet.emplace_back("", 0); // obj
-  while (getline(infile, readLine))         // ROWS section
+  while (source.NextLine(readLine))         // ROWS section
   {
-    if (readLine[0] == '*' ||
-        readLine.length() < 1)
+    if (readLine.length() < 1 ||
+        readLine[0] == '*')
       continue;
     if (readLine[0] == 'C')
       break;
-    IssSetup();
-    if (!(iss >> conType >> conName))
+    LineSetup();
+    if (!(line.NextChar(conType) && line.NextToken(conName)))
+    {
       if (!IsBlank(readLine))
         PrintfError(readLine);
       else
         continue;
+    }
     if (conType == 'L')
       conIdx = modelConUtil->MakeCon(conName);
     else if (conType == 'E')
     {
       conIdx = modelConUtil->MakeCon(conName);
       modelConUtil->conSet[conIdx].isEqual = true;
-      inverseConName = conName + "!";
-      inverseConIdx = modelConUtil->MakeCon(inverseConName);
-      modelConUtil->conSet[inverseConIdx].isEqual = true;
     }
     else if (conType == 'G')
     {
@@ -118,91 +130,145 @@ void ReaderMPS::Read(
       modelConUtil->objName = conName;
     }
   }
-  while (getline(infile, readLine)) // COLUMNS section
+  conRanges.assign(modelConUtil->conSet.size(), Infinity);
+  while (source.NextLine(readLine)) // COLUMNS section
   {
-    if (readLine[0] == '*' ||
-        readLine.length() < 1)
+    if (readLine.length() < 1 ||
+        readLine[0] == '*')
       continue;
     if (readLine[0] == 'R')
       break;
-    IssSetup();
-    if (!(iss >> varName >> conName))
+    LineSetup();
+    if (!(line.NextToken(varName) && line.NextToken(conName)))
+    {
       if (!IsBlank(readLine))
         PrintfError(readLine);
       else
         continue;
+    }
     if (conName == "\'MARKER\'")
     {
-      iss >> tempStr;
+      line.NextToken(tempStr);
       if (tempStr != "\'INTORG\'" &&
           tempStr != "\'INTEND\'")
         PrintfError(readLine);
       integralityMarker = !integralityMarker;
       continue;
     }
-    iss >> coefficient;
+    line.NextValue(coefficient);
     conIdx = modelConUtil->GetConIdx(conName);
     PushCoeffVarIdx(conIdx, coefficient, varName);
-    if (modelConUtil->conSet[conIdx].isEqual)
-      PushCoeffVarIdx(conIdx + 1, -coefficient, varName);
-    if (iss >> conName)
+    if (line.NextToken(conName))
     {
-      iss >> coefficient;
+      line.NextValue(coefficient);
       conIdx = modelConUtil->GetConIdx(conName);
       PushCoeffVarIdx(conIdx, coefficient, varName);
-      if (modelConUtil->conSet[conIdx].isEqual)
-        PushCoeffVarIdx(conIdx + 1, -coefficient, varName);
     }
   }
-  while (getline(infile, readLine)) // RHS  section
+  // RHS 段可以省略，此时 COLUMNS 之后直接是 RANGES
+  bool isRangesSection = readLine.substr(0, 6) == "RANGES";
+  while (!isRangesSection && source.NextLine(readLine)) // RHS  section
   {
-    if (readLine[0] == '*' ||
-        readLine.length() < 1)
+    if (readLine.length() < 1 ||
+        readLine[0] == '*')
       continue;
     if (readLine[0] == 'B' ||
         readLine[0] == 'E')
       break;
-    if (readLine[0] == 'R' ||
-        readLine[0] == 'S') // do not handle RANGS and SOS
+    if (readLine[0] == 'R')
+    {
+      isRangesSection = true;
+      break;
+    }
+    if (readLine[0] == 'S') // do not handle SOS
       PrintfError(readLine);
-    IssSetup();
-    if (!(iss >> tempStr >> conName >> rhs))
+    LineSetup();
+    // 自由格式允许省略 RHS 集合名，此时一行的记号数为偶数
+    bool hasSetName = line.TokenNum() % 2 == 1;
+    if (!((!hasSetName || line.NextToken(tempStr)) &&
+          line.NextToken(conName) && line.NextValue(rhs)))
+    {
       if (!IsBlank(readLine))
         PrintfError(readLine);
       else
         continue;
+    }
     if (conName.length() < 1)
       continue;
     conIdx = modelConUtil->GetConIdx(conName);
     modelConUtil->conSet[conIdx].RHS = rhs;
-    if (modelConUtil->conSet[conIdx].isEqual)
-      modelConUtil->conSet[conIdx + 1].RHS = -rhs;
 
-    if (iss >> conName)
+    if (line.NextToken(conName))
     {
-      iss >> rhs;
+      line.NextValue(rhs);
       conIdx = modelConUtil->GetConIdx(conName);
       modelConUtil->conSet[conIdx].RHS = rhs;
-      if (modelConUtil->conSet[conIdx].isEqual)
-        modelConUtil->conSet[conIdx + 1].RHS = -rhs;
     }
   }
-  while (getline(infile, readLine)) // BOUNDS section
+  while (isRangesSection && source.NextLine(readLine)) // RANGES section
   {
-    if (readLine[0] == '*' ||
-        readLine.length() < 1)
+    if (readLine.length() < 1 ||
+        readLine[0] == '*')
+      continue;
+    if (readLine[0] == 'B' ||
+        readLine[0] == 'E')
+      break;
+    if (readLine[0] == 'S') // do not handle SOS
+      PrintfError(readLine);
+    LineSetup();
+    bool hasSetName = line.TokenNum() % 2 == 1;
+    if (!((!hasSetName || line.NextToken(tempStr)) &&
+          line.NextToken(conName) && line.NextValue(range)))
+    {
+      if (!IsBlank(readLine))
+        PrintfError(readLine);
+      else
+        continue;
+    }
+    conRanges[modelConUtil->GetConIdx(conName)] = range;
+    if (line.NextToken(conName))
+    {
+      line.NextValue(range);
+      conRanges[modelConUtil->GetConIdx(conName)] = range;
+    }
+  }
+  while (source.NextLine(readLine)) // BOUNDS section
+  {
+    if (readLine.length() < 1 ||
+        readLine[0] == '*')
       continue;
     if (readLine[0] == 'E')
       break;
     if (readLine[0] == 'I') // do not handle INDICATORS
       PrintfError(readLine);
-    IssSetup();
-    if (!(iss >> varType >> tempStr >> varName))
+    LineSetup();
+    bool isRead = line.NextToken(varType);
+    // 自由格式允许省略边界集合名，按边界类型判断：带值的类型剩余 3 个记号时含集合名，
+    // FR/MI/PL 不带值，剩余 2 个记号时含集合名；BV 的值可省略，剩余 2 个记号时
+    // 既可能是“集合名 列名”也可能是“列名 值”，按首个记号是否为已知列名区分
+    size_t tokenNum = line.TokenNum();
+    bool hasSetName;
+    if (varType == "FR" || varType == "MI" || varType == "PL")
+      hasSetName = tokenNum >= 2;
+    else if (varType == "BV")
+    {
+      MPSLine peekLine = line;
+      hasSetName = tokenNum >= 3 ||
+                   (tokenNum == 2 && peekLine.NextToken(tempStr) &&
+                    modelVarUtil->name2idx.find(string(tempStr)) == modelVarUtil->name2idx.end());
+    }
+    else
+      hasSetName = tokenNum >= 3;
+    if (isRead && hasSetName)
+      isRead = line.NextToken(tempStr);
+    if (!(isRead && line.NextToken(varName)))
+    {
       if (!IsBlank(readLine))
         PrintfError(readLine);
       else
         continue;
-    iss >> inputBound;
+    }
+    line.NextValue(inputBound);
     if (modelVarUtil->name2idx.find(varName) != modelVarUtil->name2idx.end())
     {
       auto &var = modelVarUtil->GetVar(varName);
@@ -244,36 +310,68 @@ void ReaderMPS::Read(
     else
       continue;
   }
-  infile.close();
+  double parseTime = ElapsedTime(TimeNow(), clkParse);
+  double parseMB = source.ByteNum() / 1048576.0;
+  printf("c parse: %.1lf MB (%s) in %.3lf s (%.1lf MB/s)\n",
+         parseMB, source.CodecName(), parseTime, parseTime > 0 ? parseMB / parseTime : 0.0);
+  source.Close();
+  for (size_t tripletIdx = 0; tripletIdx < tripletConIdxs.size(); ++tripletIdx)
+    if (modelConUtil->conSet[tripletConIdxs[tripletIdx]].isLarge)
+      tripletCoeffs[tripletIdx] = -tripletCoeffs[tripletIdx];
+  // 统一为 lowerRHS <= a·x <= RHS：G 行取反后只有上界，E 行上下界相同；
+  // RANGES 按 MPS 约定给出另一侧，E 行的区间方向由 R 的符号决定
   for (conIdx = 1; conIdx < modelConUtil->conSet.size(); ++conIdx)
   {
     auto &con = modelConUtil->conSet[conIdx];
+    Value conRange = conRanges[conIdx];
+    bool isRanged = conRange != Infinity;
     if (con.isLarge)
     {
-      for (Value &inverseCoefficient : con.coeffSet)
-        inverseCoefficient = -inverseCoefficient;
       con.RHS = -con.RHS;
+      if (isRanged)
+        con.lowerRHS = con.RHS - fabs(conRange);
+    }
+    else if (con.isEqual)
+    {
+      con.lowerRHS = con.RHS;
+      if (isRanged && conRange > 0)
+        con.RHS += conRange;
+      else if (isRanged)
+        con.lowerRHS += conRange;
     }
+    else if (isRanged)
+      con.lowerRHS = con.RHS - fabs(conRange);
   }
+  vector<Value>().swap(conRanges);
   modelVarUtil->objBias = -modelConUtil->conSet[0].RHS;
   modelConUtil->conNum = modelConUtil->conSet.size();
   modelVarUtil->varNum = modelVarUtil->varSet.size();
+  // 行内/列内位置不超过变量数与约束数，下标类型放得下两者即可
+  if (modelConUtil->conNum > MaxIndex || modelVarUtil->varNum > MaxIndex)
+  {
+    printf("c error: %zu constraints and %zu variables exceed the %zu-bit model index; "
+           "rebuild with LMIP_INDEX64.\n",
+           modelConUtil->conNum, modelVarUtil->varNum, sizeof(Index) * 8);
+    exit(-1);
+  }
+  BuildMatrix();
 
-  if (!TightenBound() || !TightBoundGlobally())
+  if (!TightenBound() || !TightBoundGlobally() ||
+      (OPT(propagate) && (!PropagateBound() || !TightBoundGlobally())) ||
+      (OPT(reduce) && !ReduceModel()))
   {
     printf("c model is infeasible.\n");
     exit(-1);
   }
 
+  CompactMatrix();
   SetVarType();
   SetVarIdx2ObjIdx();
 }
 
-inline void ReaderMPS::IssSetup()
+inline void ReaderMPS::LineSetup()
 {
-  iss.clear();
-  iss.str(readLine);
-  iss.seekg(0, ios::beg);
+  line.Reset(readLine);
 }
 
 void ReaderMPS::PushCoeffVarIdx(
@@ -281,18 +379,198 @@ void ReaderMPS::PushCoeffVarIdx(
     Value _coeff,
     const string &_varName)
 {
-  auto &con = modelConUtil->conSet[_conIdx];
-  size_t _varIdx = modelVarUtil->MakeVar(
-      _varName, integralityMarker);
-  auto &var = modelVarUtil->GetVar(_varIdx);
-
-  var.conIdxSet.push_back(_conIdx);
-  var.posInCon.push_back(con.varIdxSet.size());
+  // COLUMNS 段同一变量的项连续出现，只在变量名变化时查表
+  if (lastVarIdx == std::numeric_limits<size_t>::max() || _varName != lastVarName)
+  {
+    lastVarIdx = modelVarUtil->MakeVar(_varName, integralityMarker);
+    lastVarName = _varName;
+  }
+  size_t _varIdx = lastVarIdx;
   if (_conIdx == 0)
     _coeff *= modelConUtil->MIN;
-  con.coeffSet.push_back(_coeff);
-  con.varIdxSet.push_back(_varIdx);
-  con.posInVar.push_back(var.conIdxSet.size() - 1);
+  tripletConIdxs.push_back(_conIdx);
+  tripletVarIdxs.push_back(_varIdx);
+  tripletCoeffs.push_back(_coeff);
+}
+
+// 由三元组一次性构建 CSR（按约束）与 CSC（按变量）两份连续存储
+void ReaderMPS::BuildMatrix()
+{
+  size_t conNum = modelConUtil->conNum;
+  size_t varNum = modelVarUtil->varNum;
+  size_t termNum = tripletConIdxs.size();
+  auto &conBegin = modelConUtil->termBegin;
+  auto &varBegin = modelVarUtil->termBegin;
+  conBegin.assign(conNum + 1, 0);
+  varBegin.assign(varNum + 1, 0);
+  for (size_t tripletIdx = 0; tripletIdx < termNum; ++tripletIdx)
+  {
+    ++conBegin[tripletConIdxs[tripletIdx] + 1];
+    ++varBegin[tripletVarIdxs[tripletIdx] + 1];
+  }
+  for (size_t conIdx = 0; conIdx < conNum; ++conIdx)
+    conBegin[conIdx + 1] += conBegin[conIdx];
+  for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+    varBegin[varIdx + 1] += varBegin[varIdx];
+
+  modelConUtil->termVarIdxs.resize(termNum);
+  modelConUtil->termCoeffs.resize(termNum);
+  modelConUtil->termPosInVar.resize(termNum);
+  vector<size_t> fill(conBegin.begin(), conBegin.end() - 1);
+  for (size_t tripletIdx = 0; tripletIdx < termNum; ++tripletIdx)
+  {
+    size_t pos = fill[tripletConIdxs[tripletIdx]]++;
+    modelConUtil->termVarIdxs[pos] = tripletVarIdxs[tripletIdx];
+    modelConUtil->termCoeffs[pos] = tripletCoeffs[tripletIdx];
+  }
+  vector<size_t>().swap(tripletConIdxs);
+  vector<size_t>().swap(tripletVarIdxs);
+  vector<Value>().swap(tripletCoeffs);
+
+  // 按约束顺序填充 CSC，保证每列内约束下标递增（目标函数总在首位）
+  modelVarUtil->termConIdxs.resize(termNum);
+  modelVarUtil->termCoeffs.resize(termNum);
+  modelVarUtil->termPosInCon.resize(termNum);
+  fill.assign(varBegin.begin(), varBegin.end() - 1);
+  for (size_t conIdx = 0; conIdx < conNum; ++conIdx)
+    for (size_t pos = conBegin[conIdx]; pos < conBegin[conIdx + 1]; ++pos)
+    {
+      size_t varPos = fill[modelConUtil->termVarIdxs[pos]]++;
+      modelVarUtil->termConIdxs[varPos] = conIdx;
+      modelVarUtil->termCoeffs[varPos] = modelConUtil->termCoeffs[pos];
+      modelVarUtil->termPosInCon[varPos] = pos - conBegin[conIdx];
+      modelConUtil->termPosInVar[pos] = varPos - varBegin[modelConUtil->termVarIdxs[pos]];
+    }
+  modelConUtil->LinkTerms();
+  modelVarUtil->LinkTerms();
+  isRemovedVar.assign(varNum, false);
+  isRemovedCon.assign(conNum, false);
+}
+
+// 去掉预处理中删除的变量所在的项，重建紧凑的 CSR/CSC；开启 reduce 时同时删去
+// 被删除或已推断满足的约束并重新编号。目标函数被改写后可能变长，此时写入新数组，否则原地压缩
+void ReaderMPS::CompactMatrix()
+{
+  size_t conNum = modelConUtil->conNum;
+  size_t varNum = modelVarUtil->varNum;
+  auto &conSet = modelConUtil->conSet;
+  auto &conBegin = modelConUtil->termBegin;
+  auto &varBegin = modelVarUtil->termBegin;
+  auto &varIdxs = modelConUtil->termVarIdxs;
+  auto &conCoeffs = modelConUtil->termCoeffs;
+  vector<Index> newVarIdxs;
+  vector<Value> newConCoeffs;
+  auto put = [&](size_t _pos, size_t _varIdx, Value _coeff)
+  {
+    if (isObjChanged)
+    {
+      newVarIdxs.push_back(_varIdx);
+      newConCoeffs.push_back(_coeff);
+    }
+    else
+    {
+      varIdxs[_pos] = _varIdx;
+      conCoeffs[_pos] = _coeff;
+    }
+  };
+  bool isDropCon = OPT(reduce);
+  size_t newPos = 0;
+  size_t oldBegin = 0;
+  size_t newConIdx = 0;
+  for (size_t conIdx = 0; conIdx < conNum; ++conIdx)
+  {
+    size_t oldEnd = conBegin[conIdx + 1];
+    if (conIdx > 0 && isDropCon && (isRemovedCon[conIdx] || conSet[conIdx].inferSAT))
+    {
+      oldBegin = oldEnd;
+      continue;
+    }
+    conBegin[newConIdx] = newPos;
+    if (conIdx == 0 && isObjChanged)
+    {
+      for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+        if (objCoeffs[varIdx] != 0)
+          put(newPos++, varIdx, objCoeffs[varIdx]);
+    }
+    else if (!isRemovedCon[conIdx])
+    {
+      for (size_t pos = oldBegin; pos < oldEnd; ++pos)
+        if (!isRemovedVar[varIdxs[pos]])
+        {
+          put(newPos, varIdxs[pos], conCoeffs[pos]);
+          ++newPos;
+        }
+    }
+    if (newConIdx != conIdx)
+    {
+      conSet[newConIdx] = std::move(conSet[conIdx]);
+      conSet[newConIdx].idx = newConIdx;
+    }
+    ++newConIdx;
+    oldBegin = oldEnd;
+  }
+  if (isObjChanged)
+  {
+    varIdxs.swap(newVarIdxs);
+    conCoeffs.swap(newConCoeffs);
+    vector<Value>().swap(objCoeffs);
+  }
+  if (newConIdx != conNum)
+  {
+    conSet.erase(conSet.begin() + newConIdx, conSet.end());
+    modelConUtil->name2idx.clear();
+    for (const auto &modelCon : conSet)
+      modelConUtil->name2idx[modelCon.name] = modelCon.idx;
+    conNum = newConIdx;
+    modelConUtil->conNum = conNum;
+  }
+  conBegin[conNum] = newPos;
+  conBegin.resize(conNum + 1);
+  conBegin.shrink_to_fit();
+  varIdxs.resize(newPos);
+  varIdxs.shrink_to_fit();
+  conCoeffs.resize(newPos);
+  conCoeffs.shrink_to_fit();
+  modelConUtil->termPosInVar.assign(newPos, 0);
+  modelConUtil->termPosInVar.shrink_to_fit();
+
+  varBegin.assign(varNum + 1, 0);
+  for (size_t pos = 0; pos < newPos; ++pos)
+    ++varBegin[varIdxs[pos] + 1];
+  for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+    varBegin[varIdx + 1] += varBegin[varIdx];
+  auto &conIdxs = modelVarUtil->termConIdxs;
+  conIdxs.resize(newPos);
+  conIdxs.shrink_to_fit();
+  modelVarUtil->termCoeffs.resize(newPos);
+  modelVarUtil->termCoeffs.shrink_to_fit();
+  modelVarUtil->termPosInCon.resize(newPos);
+  modelVarUtil->termPosInCon.shrink_to_fit();
+  vector<size_t> fill(varBegin.begin(), varBegin.end() - 1);
+  for (size_t conIdx = 0; conIdx < conNum; ++conIdx)
+    for (size_t pos = conBegin[conIdx]; pos < conBegin[conIdx + 1]; ++pos)
+    {
+      size_t varPos = fill[varIdxs[pos]]++;
+      conIdxs[varPos] = conIdx;
+      modelVarUtil->termCoeffs[varPos] = conCoeffs[pos];
+      modelVarUtil->termPosInCon[varPos] = pos - conBegin[conIdx];
+      modelConUtil->termPosInVar[pos] = varPos - varBegin[varIdxs[pos]];
+    }
+  modelConUtil->LinkTerms();
+  modelVarUtil->LinkTerms();
+}
+
+// 找到约束中唯一未被删除的项
+size_t ReaderMPS::ActiveTermIdx(
+    const ModelCon &_modelCon) const
+{
+  size_t rowLength =
+      modelConUtil->termBegin[_modelCon.idx + 1] - modelConUtil->termBegin[_modelCon.idx];
+  for (size_t termIdx = 0; termIdx < rowLength; ++termIdx)
+    if (!isRemovedVar[_modelCon.varIdxSet[termIdx]])
+      return termIdx;
+  assert(false);
+  return -1;
 }
 
 bool ReaderMPS::TightenBound()
@@ -300,13 +578,11 @@ bool ReaderMPS::TightenBound()
   for (size_t conIdx = 1; conIdx < modelConUtil->conNum; ++conIdx)
   {
     auto &modelCon = modelConUtil->conSet[conIdx];
-    if (modelCon.varIdxSet.size() == 1)
-      TightenBoundVar(modelCon);
-    if (modelCon.varIdxSet.size() == 0)
+    if (modelCon.termNum == 1)
+      TightenBoundVar(modelCon, 0);
+    if (modelCon.termNum == 0)
     {
-      assert(modelCon.coeffSet.size() == 0 &&
-             modelCon.posInVar.size() == 0);
-      if (modelCon.RHS + 1e-6 >= 0)
+      if (modelCon.RHS + 1e-6 >= 0 && modelCon.lowerRHS - 1e-6 <= 0)
       {
         modelCon.inferSAT = true;
         deleteConNum++;
@@ -321,21 +597,32 @@ bool ReaderMPS::TightenBound()
   return true;
 }
 
-void ReaderMPS::TightenBoundVar(ModelCon &modelCon)
+void ReaderMPS::TightenBoundVar(
+    ModelCon &modelCon,
+    size_t _termIdx)
 {
-  Value coeff = modelCon.coeffSet[0];
-  auto &modelvar = modelVarUtil->GetVar(modelCon.varIdxSet[0]);
+  Value coeff = modelCon.coeffSet[_termIdx];
+  auto &modelvar = modelVarUtil->GetVar(modelCon.varIdxSet[_termIdx]);
   Value newBound = (modelCon.RHS + FeasibilityTol) / coeff;
   if (coeff > 0 && newBound < modelvar.upperBound) // x <= bound
     modelvar.SetUpperBound(newBound);
   else if (coeff < 0 && modelvar.lowerBound < newBound) // x >= bound
     modelvar.SetLowerBound(newBound);
+  if (modelCon.lowerRHS == NegativeInfinity)
+    return;
+  newBound = (modelCon.lowerRHS - FeasibilityTol) / coeff;
+  if (coeff > 0 && modelvar.lowerBound < newBound) // x >= bound
+    modelvar.SetLowerBound(newBound);
+  else if (coeff < 0 && newBound < modelvar.upperBound) // x <= bound
+    modelvar.SetUpperBound(newBound);
 }
 
+// 固定变量代入：CSR/CSC 在此阶段只做惰性删除（termNum 记录剩余项数），
+// 结束后由 CompactMatrix 统一压缩
 bool ReaderMPS::TightBoundGlobally()
 {
   for (auto &modelVar : modelVarUtil->varSet)
-    if (modelVar.IsFixed())
+    if (!isRemovedVar[modelVar.idx] && modelVar.IsFixed())
     {
       modelVar.SetType(VarType::Fixed);
       fixedIdxs.push_back(modelVar.idx);
@@ -347,33 +634,27 @@ bool ReaderMPS::TightBoundGlobally()
     deleteVarNum++;
     ModelVar &removeVar = modelVarUtil->GetVar(removeVarIdx);
     Value removeVarValue = removeVar.lowerBound;
-    for (size_t termIdx = 0; termIdx < removeVar.conIdxSet.size(); termIdx++)
+    isRemovedVar[removeVarIdx] = true;
+    for (size_t termIdx = 0; termIdx < removeVar.termNum; termIdx++)
     {
       size_t conIdx = removeVar.conIdxSet[termIdx];
-      size_t posInCon = removeVar.posInCon[termIdx];
+      if (isRemovedCon[conIdx])
+        continue;
       ModelCon &modelCon = modelConUtil->GetCon(conIdx);
-      Value coeff = modelCon.coeffSet[posInCon];
-      size_t movedVarIdx = modelCon.varIdxSet.back();
-      Value movedCoeff = modelCon.coeffSet.back();
-      size_t movedPosInVar = modelCon.posInVar.back();
-      modelCon.varIdxSet[posInCon] = movedVarIdx;
-      modelCon.coeffSet[posInCon] = movedCoeff;
-      modelCon.posInVar[posInCon] = movedPosInVar;
-      ModelVar &movedVar = modelVarUtil->GetVar(movedVarIdx);
-      assert(movedVar.conIdxSet[movedPosInVar] == conIdx);
-      movedVar.posInCon[movedPosInVar] = posInCon;
-      modelCon.varIdxSet.pop_back();
-      modelCon.coeffSet.pop_back();
-      modelCon.posInVar.pop_back();
+      Value coeff = removeVar.coeffSet[termIdx];
+      --modelCon.termNum;
       if (conIdx == 0)
         modelVarUtil->objBias += coeff * removeVarValue;
       else
       {
         modelCon.RHS -= coeff * removeVarValue;
-        if (modelCon.varIdxSet.size() == 1)
+        if (modelCon.lowerRHS != NegativeInfinity)
+          modelCon.lowerRHS -= coeff * removeVarValue;
+        if (modelCon.termNum == 1)
         {
-          TightenBoundVar(modelCon);
-          ModelVar &relatedVar = modelVarUtil->GetVar(modelCon.varIdxSet[0]);
+          size_t activeTermIdx = ActiveTermIdx(modelCon);
+          TightenBoundVar(modelCon, activeTermIdx);
+          ModelVar &relatedVar = modelVarUtil->GetVar(modelCon.varIdxSet[activeTermIdx]);
           if (relatedVar.type != VarType::Fixed &&
               relatedVar.IsFixed())
           {
@@ -382,11 +663,9 @@ bool ReaderMPS::TightBoundGlobally()
             inferVarNum++;
           }
         }
-        else if (modelCon.varIdxSet.size() == 0)
+        else if (modelCon.termNum == 0)
         {
-          assert(modelCon.coeffSet.size() == 0 &&
-                 modelCon.posInVar.size() == 0);
-          if (modelCon.RHS + 1e-2 >= 0)
+          if (modelCon.RHS + 1e-2 >= 0 && modelCon.lowerRHS - 1e-2 <= 0)
           {
             modelCon.inferSAT = true;
             deleteConNum++;
@@ -403,12 +682,496 @@ bool ReaderMPS::TightBoundGlobally()
   return true;
 }
 
+// 行活动度：有限部分求和，取到无穷界的项单独计数；跳过已删除的变量
+void ReaderMPS::RowActivity(
+    const ModelCon &_modelCon,
+    RowRange &_range) const
+{
+  _range = RowRange();
+  size_t rowLength =
+      modelConUtil->termBegin[_modelCon.idx + 1] - modelConUtil->termBegin[_modelCon.idx];
+  for (size_t termIdx = 0; termIdx < rowLength; ++termIdx)
+  {
+    size_t varIdx = _modelCon.varIdxSet[termIdx];
+    if (isRemovedVar[varIdx])
+      continue;
+    const auto &modelVar = modelVarUtil->GetVar(varIdx);
+    Value coeff = _modelCon.coeffSet[termIdx];
+    Value minBound = coeff > 0 ? modelVar.lowerBound : modelVar.upperBound;
+    Value maxBound = coeff > 0 ? modelVar.upperBound : modelVar.lowerBound;
+    if (fabs(minBound) >= Infinity)
+      ++_range.minInfNum;
+    else
+      _range.minActivity += coeff * minBound;
+    if (fabs(maxBound) >= Infinity)
+      ++_range.maxInfNum;
+    else
+      _range.maxActivity += coeff * maxBound;
+  }
+}
+
+// 由其余项的活动度推出第 _termIdx 项变量的界，推不出的一侧为无穷：
+// 其余项的最小活动度在本项有限时减去本项贡献，本项是唯一的无穷项时即为有限部分
+void ReaderMPS::ImpliedBound(
+    const ModelCon &_modelCon,
+    size_t _termIdx,
+    const RowRange &_range,
+    Value &_newLower,
+    Value &_newUpper) const
+{
+  const auto &modelVar = modelVarUtil->GetVar(_modelCon.varIdxSet[_termIdx]);
+  Value coeff = _modelCon.coeffSet[_termIdx];
+  _newLower = NegativeInfinity;
+  _newUpper = Infinity;
+  Value minBound = coeff > 0 ? modelVar.lowerBound : modelVar.upperBound;
+  bool isMinInf = fabs(minBound) >= Infinity;
+  if (_range.minInfNum == 0 || (_range.minInfNum == 1 && isMinInf))
+  {
+    Value restMin = isMinInf ? _range.minActivity : _range.minActivity - coeff * minBound;
+    Value bound = (_modelCon.RHS - restMin) / coeff;
+    if (coeff > 0)
+      _newUpper = bound;
+    else
+      _newLower = bound;
+  }
+  if (_modelCon.lowerRHS == NegativeInfinity)
+    return;
+  Value maxBound = coeff > 0 ? modelVar.upperBound : modelVar.lowerBound;
+  bool isMaxInf = fabs(maxBound) >= Infinity;
+  if (_range.maxInfNum == 0 || (_range.maxInfNum == 1 && isMaxInf))
+  {
+    Value restMax = isMaxInf ? _range.maxActivity : _range.maxActivity - coeff * maxBound;
+    Value bound = (_modelCon.lowerRHS - restMax) / coeff;
+    if (coeff > 0)
+      _newLower = bound;
+    else
+      _newUpper = bound;
+  }
+}
+
+// 界传播（FBBT）：由其余变量的最小/最大活动度推出每个变量的界，
+// 变量的界收紧后把它所在的约束重新入队，直到不动点或工作量（访问的项数）用尽；
+// 新固定的变量交给随后的 TightBoundGlobally 代入
+bool ReaderMPS::PropagateBound()
+{
+  size_t conNum = modelConUtil->conNum;
+  vector<bool> isQueued(conNum, false);
+  deque<size_t> conQueue;
+  for (size_t conIdx = 1; conIdx < conNum; ++conIdx)
+    if (modelConUtil->conSet[conIdx].termNum > 1 && !isRemovedCon[conIdx])
+    {
+      isQueued[conIdx] = true;
+      conQueue.push_back(conIdx);
+    }
+  double work = 0;
+  double workLimit = OPT(propagateWork);
+  size_t visitNum = 0;
+  RowRange range;
+  while (!conQueue.empty() && work < workLimit)
+  {
+    size_t conIdx = conQueue.front();
+    conQueue.pop_front();
+    isQueued[conIdx] = false;
+    const auto &modelCon = modelConUtil->conSet[conIdx];
+    if (modelCon.termNum < 2)
+      continue;
+    size_t rowLength = modelConUtil->termBegin[conIdx + 1] - modelConUtil->termBegin[conIdx];
+    work += rowLength;
+    ++visitNum;
+    RowActivity(modelCon, range);
+    if (range.minInfNum == 0 &&
+        range.minActivity > modelCon.RHS + FeasibilityTol * max(1.0, fabs(modelCon.RHS)))
+    {
+      printf("c con %s: min activity %lf > rhs %lf\n",
+             modelCon.name.c_str(), range.minActivity, modelCon.RHS);
+      return false;
+    }
+    if (range.maxInfNum == 0 && modelCon.lowerRHS != NegativeInfinity &&
+        range.maxActivity < modelCon.lowerRHS - FeasibilityTol * max(1.0, fabs(modelCon.lowerRHS)))
+    {
+      printf("c con %s: max activity %lf < lhs %lf\n",
+             modelCon.name.c_str(), range.maxActivity, modelCon.lowerRHS);
+      return false;
+    }
+    if (range.minInfNum > 1 && (modelCon.lowerRHS == NegativeInfinity || range.maxInfNum > 1))
+      continue;
+
+    for (size_t termIdx = 0; termIdx < rowLength; ++termIdx)
+    {
+      size_t varIdx = modelCon.varIdxSet[termIdx];
+      if (isRemovedVar[varIdx])
+        continue;
+      auto &modelVar = modelVarUtil->GetVar(varIdx);
+      Value newLower;
+      Value newUpper;
+      ImpliedBound(modelCon, termIdx, range, newLower, newUpper);
+      int tightenResult = PropagateVarBound(modelVar, newLower, newUpper);
+      if (tightenResult < 0)
+      {
+        printf("c %s LB: %lf; UB: %lf\n",
+               modelVar.name.c_str(), modelVar.lowerBound, modelVar.upperBound);
+        return false;
+      }
+      if (tightenResult == 0)
+        continue;
+      work += modelVar.termNum;
+      for (size_t varTermIdx = 0; varTermIdx < modelVar.termNum; ++varTermIdx)
+      {
+        size_t relatedConIdx = modelVar.conIdxSet[varTermIdx];
+        if (relatedConIdx != 0 && relatedConIdx != conIdx &&
+            !isRemovedCon[relatedConIdx] && !isQueued[relatedConIdx])
+        {
+          isQueued[relatedConIdx] = true;
+          conQueue.push_back(relatedConIdx);
+        }
+      }
+    }
+  }
+  printf("c propagate: %zu bounds tightened in %zu row visits%s\n",
+         propagateBoundNum, visitNum, conQueue.empty() ? "" : " (work limit reached)");
+  return true;
+}
+
+// 返回 1 表示界被收紧，0 表示未变，-1 表示上下界矛盾；
+// 推出的界放宽一个相对容差后再取整，过大的界不可靠不予采用；
+// 连续变量只接受显著的收紧，避免在不动点附近反复做微小收紧
+int ReaderMPS::PropagateVarBound(
+    ModelVar &_modelVar,
+    Value _newLower,
+    Value _newUpper)
+{
+  const Value boundLimit = 1e9;
+  const Value minChange = 1e-3;
+  bool isReal = _modelVar.type == VarType::Real;
+  bool isTightened = false;
+  if (_newUpper < boundLimit)
+  {
+    Value bound = _newUpper + FeasibilityTol * max(1.0, fabs(_newUpper));
+    Value oldUpper = _modelVar.upperBound;
+    if (isReal ? bound < oldUpper - minChange * max(1.0, fabs(oldUpper))
+               : floor(bound) < oldUpper)
+    {
+      _modelVar.SetUpperBound(bound);
+      isTightened = true;
+    }
+  }
+  if (_newLower > -boundLimit)
+  {
+    Value bound = _newLower - FeasibilityTol * max(1.0, fabs(_newLower));
+    Value oldLower = _modelVar.lowerBound;
+    if (isReal ? bound > oldLower + minChange * max(1.0, fabs(oldLower))
+               : ceil(bound) > oldLower)
+    {
+      _modelVar.SetLowerBound(bound);
+      isTightened = true;
+    }
+  }
+  if (!isTightened)
+    return 0;
+  if (_modelVar.lowerBound > _modelVar.upperBound)
+  {
+    if (_modelVar.lowerBound > _modelVar.upperBound + FeasibilityTol * max(1.0, fabs(_modelVar.upperBound)))
+      return -1;
+    // 连续变量两侧的容差交叉时固定在中点
+    Value mid = (_modelVar.lowerBound + _modelVar.upperBound) / 2;
+    _modelVar.lowerBound = _modelVar.upperBound = mid;
+  }
+  ++propagateBoundNum;
+  return 1;
+}
+
+// 依次删除冗余约束、合并平行约束、固定被占优的列并代入，最后消去自由单元素列
+bool ReaderMPS::ReduceModel()
+{
+  RemoveRedundantCons();
+  if (!MergeParallelCons())
+    return false;
+  FixDominatedVars();
+  if (!TightBoundGlobally())
+    return false;
+  EliminateFreeSingletons();
+  printf("c presolve: %zu redundant rows, %zu parallel rows removed; "
+         "%zu dominated columns fixed, %zu free singleton columns eliminated\n",
+         redundantConNum, parallelConNum, dominatedVarNum, singletonVarNum);
+  return true;
+}
+
+// 变量取任意界内值都满足的约束
+void ReaderMPS::RemoveRedundantCons()
+{
+  RowRange range;
+  for (size_t conIdx = 1; conIdx < modelConUtil->conNum; ++conIdx)
+  {
+    const auto &modelCon = modelConUtil->conSet[conIdx];
+    if (isRemovedCon[conIdx] || modelCon.termNum == 0)
+      continue;
+    RowActivity(modelCon, range);
+    bool isUpperRedundant =
+        range.maxInfNum == 0 &&
+        range.maxActivity <= modelCon.RHS + RedundantTol * max(1.0, fabs(modelCon.RHS));
+    bool isLowerRedundant =
+        modelCon.lowerRHS == NegativeInfinity ||
+        (range.minInfNum == 0 &&
+         range.minActivity >= modelCon.lowerRHS - RedundantTol * max(1.0, fabs(modelCon.lowerRHS)));
+    if (isUpperRedundant && isLowerRedundant)
+    {
+      isRemovedCon[conIdx] = true;
+      ++redundantConNum;
+      ++deleteConNum;
+    }
+  }
+}
+
+// 约束按编号最小的变量的系数归一化，平行约束归一化后完全相同
+static Value ScaleSide(
+    Value _side,
+    Value _scale)
+{
+  if (fabs(_side) >= Infinity)
+    return (_side > 0) == (_scale > 0) ? Infinity : NegativeInfinity;
+  return _side * _scale;
+}
+
+void ReaderMPS::NormalizedRow(
+    const ModelCon &_modelCon,
+    vector<pair<size_t, Value>> &_terms,
+    Value &_scale) const
+{
+  _terms.clear();
+  size_t rowLength =
+      modelConUtil->termBegin[_modelCon.idx + 1] - modelConUtil->termBegin[_modelCon.idx];
+  for (size_t termIdx = 0; termIdx < rowLength; ++termIdx)
+    if (!isRemovedVar[_modelCon.varIdxSet[termIdx]])
+      _terms.emplace_back(_modelCon.varIdxSet[termIdx], _modelCon.coeffSet[termIdx]);
+  sort(_terms.begin(), _terms.end());
+  _scale = 1 / _terms[0].second;
+  for (auto &term : _terms)
+    term.second *= _scale;
+}
+
+// 归一化后的约束按散列分组，同组内逐项比较确认平行后，
+// 把两侧取交集并入先出现的约束，删除后出现的约束；交集为空时模型不可行
+bool ReaderMPS::MergeParallelCons()
+{
+  vector<pair<uint64_t, size_t>> conHashes;
+  vector<pair<size_t, Value>> terms;
+  Value scale;
+  for (size_t conIdx = 1; conIdx < modelConUtil->conNum; ++conIdx)
+  {
+    const auto &modelCon = modelConUtil->conSet[conIdx];
+    if (isRemovedCon[conIdx] || modelCon.termNum == 0)
+      continue;
+    NormalizedRow(modelCon, terms, scale);
+    uint64_t hash = terms.size();
+    for (const auto &term : terms)
+    {
+      uint64_t key = term.first * 0x9e3779b97f4a7c15ULL ^ (uint64_t)llround(term.second * 1e6);
+      key ^= key >> 31;
+      key *= 0xbf58476d1ce4e5b9ULL;
+      hash = hash * 0x100000001b3ULL + (key ^ key >> 29);
+    }
+    conHashes.emplace_back(hash, conIdx);
+  }
+  sort(conHashes.begin(), conHashes.end());
+
+  vector<pair<size_t, Value>> keptTerms;
+  Value keptScale;
+  for (size_t begin = 0, end; begin < conHashes.size(); begin = end)
+  {
+    for (end = begin + 1; end < conHashes.size() && conHashes[end].first == conHashes[begin].first; ++end)
+      ;
+    if (end - begin == 1)
+      continue;
+    auto &keptCon = modelConUtil->conSet[conHashes[begin].second];
+    NormalizedRow(keptCon, keptTerms, keptScale);
+    for (size_t hashIdx = begin + 1; hashIdx < end; ++hashIdx)
+    {
+      size_t conIdx = conHashes[hashIdx].second;
+      const auto &modelCon = modelConUtil->conSet[conIdx];
+      NormalizedRow(modelCon, terms, scale);
+      bool isParallel = terms.size() == keptTerms.size();
+      for (size_t termIdx = 0; termIdx < terms.size() && isParallel; ++termIdx)
+        isParallel = terms[termIdx].first == keptTerms[termIdx].first &&
+                     fabs(terms[termIdx].second - keptTerms[termIdx].second) <=
+                         RedundantTol * max(1.0, fabs(keptTerms[termIdx].second));
+      if (!isParallel)
+        continue;
+
+      // 在归一化的尺度下求两侧的交集，再换回保留约束的尺度
+      Value keptLower = ScaleSide(keptScale > 0 ? keptCon.lowerRHS : keptCon.RHS, keptScale);
+      Value keptUpper = ScaleSide(keptScale > 0 ? keptCon.RHS : keptCon.lowerRHS, keptScale);
+      Value lower = ScaleSide(scale > 0 ? modelCon.lowerRHS : modelCon.RHS, scale);
+      Value upper = ScaleSide(scale > 0 ? modelCon.RHS : modelCon.lowerRHS, scale);
+      lower = max(lower, keptLower);
+      upper = min(upper, keptUpper);
+      if (lower > upper)
+      {
+        if (lower > upper + FeasibilityTol * max(1.0, fabs(upper)))
+        {
+          printf("c con %s and %s: parallel rows with disjoint sides\n",
+                 keptCon.name.c_str(), modelCon.name.c_str());
+          return false;
+        }
+        lower = upper;
+      }
+      keptCon.RHS = ScaleSide(keptScale > 0 ? upper : lower, 1 / keptScale);
+      keptCon.lowerRHS = ScaleSide(keptScale > 0 ? lower : upper, 1 / keptScale);
+      isRemovedCon[conIdx] = true;
+      ++parallelConNum;
+      ++deleteConNum;
+    }
+  }
+  return true;
+}
+
+// 对偶固定：沿某一方向移动变量既不增大目标也不会使任何约束变差时，把变量固定在该方向的界上
+void ReaderMPS::FixDominatedVars()
+{
+  for (auto &modelVar : modelVarUtil->varSet)
+  {
+    if (isRemovedVar[modelVar.idx] || modelVar.IsFixed())
+      continue;
+    Value objCoeff = 0;
+    bool isDownFree = true; // 减小变量不会使任何约束变差
+    bool isUpFree = true;
+    for (size_t termIdx = 0; termIdx < modelVar.termNum; ++termIdx)
+    {
+      size_t conIdx = modelVar.conIdxSet[termIdx];
+      Value coeff = modelVar.coeffSet[termIdx];
+      if (conIdx == 0)
+      {
+        objCoeff = coeff;
+        continue;
+      }
+      if (isRemovedCon[conIdx])
+        continue;
+      const auto &modelCon = modelConUtil->conSet[conIdx];
+      bool hasUpper = fabs(modelCon.RHS) < Infinity;
+      bool hasLower = modelCon.lowerRHS != NegativeInfinity;
+      if (coeff > 0 ? hasLower : hasUpper)
+        isDownFree = false;
+      if (coeff > 0 ? hasUpper : hasLower)
+        isUpFree = false;
+    }
+    if (isDownFree && objCoeff >= 0 && fabs(modelVar.lowerBound) < Infinity)
+      modelVar.upperBound = modelVar.lowerBound;
+    else if (isUpFree && objCoeff <= 0 && fabs(modelVar.upperBound) < Infinity)
+      modelVar.lowerBound = modelVar.upperBound;
+    else
+      continue;
+    ++dominatedVarNum;
+  }
+}
+
+// 只出现在一个约束中、且界由该约束隐含（隐含自由）的连续变量：
+// 目标系数为 0 时约束总能由它满足，直接删除约束；否则它在最优解中取约束的一侧，
+// 把该侧作为等式代入目标函数后删除约束。被消去的变量记入后处理栈，输出前恢复
+void ReaderMPS::EliminateFreeSingletons()
+{
+  // 目标系数从列中读取：列内约束下标递增，目标函数若出现必为第一项；已删除（含已固定代入）的变量不计
+  size_t varNum = modelVarUtil->varNum;
+  objCoeffs.assign(varNum, 0);
+  for (const auto &modelVar : modelVarUtil->varSet)
+    if (!isRemovedVar[modelVar.idx] && modelVar.termNum > 0 && modelVar.conIdxSet[0] == 0)
+      objCoeffs[modelVar.idx] = modelVar.coeffSet[0];
+
+  auto &postsolve = modelVarUtil->postsolve;
+  vector<bool> isQueued(varNum, true);
+  deque<size_t> varQueue;
+  for (size_t varIdx = 0; varIdx < varNum; ++varIdx)
+    varQueue.push_back(varIdx);
+  RowRange range;
+  while (!varQueue.empty())
+  {
+    size_t varIdx = varQueue.front();
+    varQueue.pop_front();
+    isQueued[varIdx] = false;
+    auto &modelVar = modelVarUtil->GetVar(varIdx);
+    if (isRemovedVar[varIdx] || modelVar.type != VarType::Real)
+      continue;
+    size_t conIdx = 0;
+    size_t conCount = 0;
+    for (size_t termIdx = 0; termIdx < modelVar.termNum && conCount < 2; ++termIdx)
+      if (modelVar.conIdxSet[termIdx] != 0 && !isRemovedCon[modelVar.conIdxSet[termIdx]])
+      {
+        conIdx = modelVar.conIdxSet[termIdx];
+        ++conCount;
+      }
+    if (conCount != 1)
+      continue;
+
+    auto &modelCon = modelConUtil->conSet[conIdx];
+    size_t rowLength = modelConUtil->termBegin[conIdx + 1] - modelConUtil->termBegin[conIdx];
+    const size_t noPivot = std::numeric_limits<size_t>::max();
+    size_t pivotIdx = noPivot;
+    Value maxCoeff = 0;
+    for (size_t termIdx = 0; termIdx < rowLength; ++termIdx)
+      if (!isRemovedVar[modelCon.varIdxSet[termIdx]])
+      {
+        maxCoeff = max(maxCoeff, fabs(modelCon.coeffSet[termIdx]));
+        if (modelCon.varIdxSet[termIdx] == varIdx)
+          pivotIdx = termIdx;
+      }
+    // 变量在该行中的项已被删除时没有主元
+    if (pivotIdx == noPivot)
+      continue;
+    Value pivotCoeff = modelCon.coeffSet[pivotIdx];
+    if (fabs(pivotCoeff) < PivotTol * maxCoeff)
+      continue;
+    RowActivity(modelCon, range);
+    Value impliedLower;
+    Value impliedUpper;
+    ImpliedBound(modelCon, pivotIdx, range, impliedLower, impliedUpper);
+    if ((fabs(modelVar.lowerBound) < Infinity &&
+         impliedLower < modelVar.lowerBound - FeasibilityTol * max(1.0, fabs(modelVar.lowerBound))) ||
+        (fabs(modelVar.upperBound) < Infinity &&
+         impliedUpper > modelVar.upperBound + FeasibilityTol * max(1.0, fabs(modelVar.upperBound))))
+      continue;
+
+    // 目标系数与约束系数同号时变量取最小，落在约束下侧；异号时落在上侧
+    Value objCoeff = objCoeffs[varIdx];
+    Value lowerSide = modelCon.lowerRHS;
+    Value upperSide = modelCon.RHS;
+    if (objCoeff != 0)
+    {
+      Value side = objCoeff / pivotCoeff > 0 ? modelCon.lowerRHS : modelCon.RHS;
+      if (fabs(side) >= Infinity)
+        continue;
+      lowerSide = upperSide = side;
+      modelVarUtil->objBias += objCoeff * side / pivotCoeff;
+      isObjChanged = true;
+    }
+    postsolve.Push(varIdx, pivotCoeff, lowerSide, upperSide,
+                   modelVar.lowerBound, modelVar.upperBound);
+    for (size_t termIdx = 0; termIdx < rowLength; ++termIdx)
+    {
+      size_t relatedVarIdx = modelCon.varIdxSet[termIdx];
+      if (termIdx == pivotIdx || isRemovedVar[relatedVarIdx])
+        continue;
+      postsolve.PushTerm(relatedVarIdx, modelCon.coeffSet[termIdx]);
+      objCoeffs[relatedVarIdx] -= objCoeff * modelCon.coeffSet[termIdx] / pivotCoeff;
+      if (!isQueued[relatedVarIdx])
+      {
+        isQueued[relatedVarIdx] = true;
+        varQueue.push_back(relatedVarIdx);
+      }
+    }
+    objCoeffs[varIdx] = 0;
+    isRemovedVar[varIdx] = true;
+    isRemovedCon[conIdx] = true;
+    modelVar.lowerBound = modelVar.upperBound = 0;
+    modelVar.SetType(VarType::Fixed);
+    ++singletonVarNum;
+    ++deleteVarNum;
+    ++deleteConNum;
+  }
+}
+
 bool ReaderMPS::SetVarType()
 {
   for (size_t varIdx = 0; varIdx < modelVarUtil->varNum; varIdx++)
   {
     auto &modelVar = modelVarUtil->GetVar(varIdx);
-    modelVar.termNum = modelVar.conIdxSet.size();
     if (modelVar.lowerBound >= modelVar.upperBound + FeasibilityTol)
     {
       printf(
@@ -439,7 +1202,6 @@ bool ReaderMPS::SetVarType()
   for (size_t conIdx = 0; conIdx < modelConUtil->conNum; conIdx++)
   {
     auto &modelCon = modelConUtil->GetCon(conIdx);
-    modelCon.termNum = modelCon.varIdxSet.size();
     if (modelCon.inferSAT)
       assert(modelCon.termNum == 0);
   }
@@ -18,25 +18,80 @@
 #include "utils/paras.h"
 #include "ModelCon.h"
 #include "ModelVar.h"
+#include "MPSSource.h"
+
+// 约束的活动度范围：有限部分之和与取到无穷界的项数
+struct RowRange
+{
+  Value minActivity = 0;
+  Value maxActivity = 0;
+  size_t minInfNum = 0;
+  size_t maxInfNum = 0;
+};
 
 class ReaderMPS
 {
 private:
   ModelConUtil *modelConUtil;
   ModelVarUtil *modelVarUtil;
-  istringstream iss;
-  string readLine;
+  MPSSource source;
+  MPSLine line;
+  std::string_view readLine;
   bool integralityMarker;
+  string lastVarName;
+  size_t lastVarIdx;
   bool TightenBound();
-  void TightenBoundVar(ModelCon &_modelCon);
+  void TightenBoundVar(
+      ModelCon &_modelCon,
+      size_t _termIdx);
   bool TightBoundGlobally();
+  void RowActivity(
+      const ModelCon &_modelCon,
+      RowRange &_range) const;
+  void ImpliedBound(
+      const ModelCon &_modelCon,
+      size_t _termIdx,
+      const RowRange &_range,
+      Value &_newLower,
+      Value &_newUpper) const;
+  bool PropagateBound();
+  int PropagateVarBound(
+      ModelVar &_modelVar,
+      Value _newLower,
+      Value _newUpper);
+  bool ReduceModel();
+  void RemoveRedundantCons();
+  void NormalizedRow(
+      const ModelCon &_modelCon,
+      vector<pair<size_t, Value>> &_terms,
+      Value &_scale) const;
+  bool MergeParallelCons();
+  void FixDominatedVars();
+  void EliminateFreeSingletons();
   bool SetVarType();
   void SetVarIdx2ObjIdx();
+  void BuildMatrix();
+  void CompactMatrix();
+  size_t ActiveTermIdx(
+      const ModelCon &_modelCon) const;
   vector<size_t> fixedIdxs;
+  vector<bool> isRemovedVar;
+  vector<bool> isRemovedCon;
+  vector<Value> objCoeffs;
+  vector<size_t> tripletConIdxs;
+  vector<size_t> tripletVarIdxs;
+  vector<Value> tripletCoeffs;
+  vector<Value> conRanges;
   size_t deleteConNum;
   size_t deleteVarNum;
   size_t inferVarNum;
-  inline void IssSetup();
+  size_t propagateBoundNum;
+  size_t redundantConNum;
+  size_t parallelConNum;
+  size_t dominatedVarNum;
+  size_t singletonVarNum;
+  bool isObjChanged;
+  inline void LineSetup();
   void PushCoeffVarIdx(
       const size_t _conIdx,
       Value _coeff,
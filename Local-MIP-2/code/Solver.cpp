@@ -21,6 +21,7 @@ Solver::Solver()
   modelConUtil = new ModelConUtil();
   modelVarUtil = new ModelVarUtil();
   readerMPS = new ReaderMPS(modelConUtil, modelVarUtil);
+  modelSnapshot = new ModelSnapshot();
   localMIP = new LocalMIP(modelConUtil, modelVarUtil);
 }
 
@@ -31,13 +32,240 @@ Solver::~Solver()
 void Solver::Run()
 {
   ParseObj();
-  readerMPS->Read(fileName);
+  ReadModel();
+  if (OPT(decompose) > 0 && RunComponents())
+    return;
+  if (OPT(threads) > 1)
+  {
+    RunPortfolio();
+    return;
+  }
   int Result = localMIP->LocalSearch(optimalObj, clkStart);
   localMIP->PrintResult();
 }
 
+// 多线程组合求解：各线程共享只读模型与最优解公告板，各自持有局部状态；
+// 任一线程达到最优目标后通知其余线程停止，最后只输出最优线程的结果
+void Solver::RunPortfolio()
+{
+  size_t threadNum = OPT(threads);
+  portfolioMIPs.push_back(localMIP);
+  for (size_t slot = 1; slot < threadNum; ++slot)
+    portfolioMIPs.push_back(new LocalMIP(modelConUtil, modelVarUtil));
+  IncumbentBoard incumbentBoard(modelVarUtil->varNum);
+  vector<std::thread> workers;
+  for (size_t slot = 0; slot < threadNum; ++slot)
+  {
+    portfolioMIPs[slot]->SetPortfolioSlot(slot);
+    portfolioMIPs[slot]->SetIncumbentBoard(&incumbentBoard);
+    workers.emplace_back(
+        [this, slot]()
+        {
+          if (portfolioMIPs[slot]->LocalSearch(optimalObj, clkStart))
+            for (auto *other : portfolioMIPs)
+              other->Stop();
+        });
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  size_t bestSlot = 0;
+  size_t totalStepNum = 0;
+  for (size_t slot = 0; slot < threadNum; ++slot)
+  {
+    auto *mip = portfolioMIPs[slot];
+    totalStepNum += mip->GetStepNum();
+    if (mip->IsFoundFeasible())
+      printf("c thread %-3ld objective: %-20lf steps: %ld\n",
+             slot, mip->GetObjValue(), mip->GetStepNum());
+    else
+      printf("c thread %-3ld no feasible solution; steps: %ld\n",
+             slot, mip->GetStepNum());
+    auto *best = portfolioMIPs[bestSlot];
+    if (mip->IsFoundFeasible() &&
+        (!best->IsFoundFeasible() || mip->GetBestOBJ() < best->GetBestOBJ()))
+      bestSlot = slot;
+  }
+  printf("c portfolio: %ld threads; %ld steps in total; best from thread %ld\n",
+         threadNum, totalStepNum, bestSlot);
+  portfolioMIPs[bestSlot]->PrintResult();
+}
+
+// 按连通分量分组，各组子模型在独立线程上搜索；主线程轮询各组的最优目标值，
+// 全部可行后以其和作为全局目标值输出。含约束的分量不多于一个时返回 false，退回整体求解
+bool Solver::RunComponents()
+{
+  Decomposer decomposer(modelConUtil, modelVarUtil);
+  size_t groupNum = decomposer.Decompose(OPT(decompose));
+  printf("c decomposition: %ld components (%ld with constraints) in %ld groups\n",
+         decomposer.componentNum, decomposer.conComponentNum, groupNum);
+  if (decomposer.conComponentNum <= 1)
+    return false;
+
+  vector<unique_ptr<IncumbentBoard>> boards;
+  for (size_t groupIdx = 0; groupIdx < groupNum; ++groupIdx)
+  {
+    componentMIPs.push_back(new LocalMIP(
+        decomposer.groupConUtils[groupIdx], decomposer.groupVarUtils[groupIdx]));
+    boards.emplace_back(new IncumbentBoard(decomposer.groupVarUtils[groupIdx]->varNum));
+    componentMIPs[groupIdx]->SetIncumbentBoard(boards[groupIdx].get());
+    componentMIPs[groupIdx]->SetLogObj(false);
+  }
+  vector<std::thread> workers;
+  std::atomic<size_t> finishNum(0);
+  for (size_t groupIdx = 0; groupIdx < groupNum; ++groupIdx)
+  {
+    // 目标函数中没有本组变量时，找到可行解即为最优
+    auto *groupConUtil = decomposer.groupConUtils[groupIdx];
+    Value groupOptimalObj =
+        groupConUtil->conSet[0].termNum == 0
+            ? groupConUtil->MIN * decomposer.groupVarUtils[groupIdx]->objBias
+            : NegativeInfinity;
+    workers.emplace_back(
+        [this, groupIdx, groupOptimalObj, &finishNum]()
+        {
+          componentMIPs[groupIdx]->LocalSearch(groupOptimalObj, clkStart);
+          ++finishNum;
+        });
+  }
+
+  Value bestOBJ = Infinity;
+  double runTime = -1;
+  while (true)
+  {
+    bool isFinished = finishNum.load() == groupNum;
+    Value sumOBJ = 0;
+    bool isAllFeasible = true;
+    for (auto &board : boards)
+    {
+      Value boardOBJ = board->BestOBJ();
+      isAllFeasible = isAllFeasible && boardOBJ < Infinity;
+      sumOBJ += boardOBJ;
+    }
+    if (isAllFeasible && sumOBJ < bestOBJ)
+    {
+      bestOBJ = sumOBJ;
+      runTime = ElapsedTime(TimeNow(), clkStart);
+      Value objValue = modelConUtil->MIN * (bestOBJ + modelVarUtil->objBias);
+      printf("n %-20f %lf\n", objValue, runTime);
+      if (objValue <= optimalObj)
+        for (auto *mip : componentMIPs)
+          mip->Stop();
+    }
+    if (isFinished)
+      break;
+    std::this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  vector<Value> values(modelVarUtil->varNum, 0);
+  vector<Value> groupValues;
+  bool isFeasible = true;
+  for (size_t groupIdx = 0; groupIdx < groupNum; ++groupIdx)
+  {
+    auto *mip = componentMIPs[groupIdx];
+    const auto &varIdxs = decomposer.groupVarIdxs[groupIdx];
+    groupValues.resize(varIdxs.size());
+    Value groupOBJ;
+    if (boards[groupIdx]->Read(groupValues, groupOBJ))
+    {
+      for (size_t subIdx = 0; subIdx < varIdxs.size(); ++subIdx)
+        values[varIdxs[subIdx]] = groupValues[subIdx];
+      printf("c group %-3ld vars: %-8ld cons: %-8ld objective: %-20lf steps: %ld\n",
+             groupIdx, varIdxs.size(), decomposer.groupConUtils[groupIdx]->conNum - 1,
+             mip->GetObjValue(), mip->GetStepNum());
+    }
+    else
+    {
+      isFeasible = false;
+      printf("c group %-3ld vars: %-8ld cons: %-8ld no feasible solution; steps: %ld\n",
+             groupIdx, varIdxs.size(), decomposer.groupConUtils[groupIdx]->conNum - 1,
+             mip->GetStepNum());
+    }
+  }
+
+  // 在预处理后的模型上检验拼接后的解；被约简的行已不在模型中，消去的变量在输出前由后处理栈恢复
+  int win = 0;
+  if (!isFeasible)
+    printf("o no feasible solution found.\n");
+  else
+  {
+    bool isVerified = true;
+    for (size_t varIdx = 0; varIdx < modelVarUtil->varNum && isVerified; ++varIdx)
+      isVerified = modelVarUtil->varSet[varIdx].InBound(values[varIdx]);
+    for (size_t conIdx = 1; conIdx < modelConUtil->conNum && isVerified; ++conIdx)
+    {
+      const auto &modelCon = modelConUtil->conSet[conIdx];
+      Value LHS = 0;
+      for (size_t termIdx = 0; termIdx < modelCon.termNum; ++termIdx)
+        LHS += modelCon.coeffSet[termIdx] * values[modelCon.varIdxSet[termIdx]];
+      isVerified = LHS <= modelCon.RHS + FeasibilityTol &&
+                   LHS >= modelCon.lowerRHS - FeasibilityTol;
+    }
+    if (isVerified)
+    {
+      win = 1;
+      printf("o Best objective: %lf\n", modelConUtil->MIN * (bestOBJ + modelVarUtil->objBias));
+      if (OPT(PrintSol))
+      {
+        modelVarUtil->postsolve.Apply(values);
+        printf("c best-found solution:\n");
+        printf("%-50s        %s\n", "Variable name", "Variable value");
+        for (size_t varIdx = 0; varIdx < modelVarUtil->varNum; varIdx++)
+          if (values[varIdx])
+            printf("%-50s        %lf\n", modelVarUtil->varSet[varIdx].name.c_str(), values[varIdx]);
+      }
+    }
+    else
+      cout << "solution verify failed." << endl;
+  }
+  save_result((char *)OPT(log).c_str(), win, runTime, bestOBJ);
+  return true;
+}
+
+// 快照中的项数组直接映射使用，modelSnapshot 在求解结束前不释放
+void Solver::ReadModel()
+{
+  auto clk = TimeNow();
+  if (!OPT(loadModel).empty())
+  {
+    if (!modelSnapshot->Load(OPT(loadModel).c_str(), modelConUtil, modelVarUtil))
+    {
+      printf("c error: %s is not a valid model snapshot.\n", OPT(loadModel).c_str());
+      exit(-1);
+    }
+    printf("c load snapshot: %zu constraints, %zu variables in %.3lf s\n",
+           modelConUtil->conNum, modelVarUtil->varNum,
+           ElapsedTime(TimeNow(), clk));
+  }
+  else
+    readerMPS->Read(fileName);
+  if (!OPT(saveModel).empty())
+  {
+    clk = TimeNow();
+    if (!ModelSnapshot::Save(OPT(saveModel).c_str(), modelConUtil, modelVarUtil, OPT(snapshotNames)))
+    {
+      printf("c error: failed to write model snapshot %s.\n", OPT(saveModel).c_str());
+      exit(-1);
+    }
+    printf("c save snapshot: %s in %.3lf s\n", OPT(saveModel).c_str(),
+           ElapsedTime(TimeNow(), clk));
+  }
+  if (OPT(intEngine))
+  {
+    modelConUtil->DetectIntegral(*modelVarUtil);
+    printf("c integer engine: %s\n", modelConUtil->isIntegral ? "on (integral model)" : "off (model is not integral)");
+  }
+}
+
 void Solver::ParseObj()
 {
-  fileName = (char *)OPT(instance).c_str();
+  if (OPT(instance).empty() && OPT(loadModel).empty())
+  {
+    printf("c error: either --instance or --loadModel is required.\n");
+    exit(-1);
+  }
+  fileName = (char *)(OPT(instance).empty() ? OPT(loadModel) : OPT(instance)).c_str();
   optimalObj = __global_paras.identify_opt(fileName);
 }
\ No newline at end of file
@@ -19,7 +19,10 @@
 #include "ReaderMPS.h"
 #include "ModelCon.h"
 #include "ModelVar.h"
+#include "Decomposer.h"
+#include "ModelSnapshot.h"
 #include "LocalSearch/LocalMIP.h"
+#include <thread>
 
 class Solver
 {
@@ -27,12 +30,18 @@ private:
   char *fileName;
   Value optimalObj;
   void ParseObj();
+  void ReadModel();
+  void RunPortfolio();
+  bool RunComponents();
 
 public:
   ReaderMPS *readerMPS;
+  ModelSnapshot *modelSnapshot;
   ModelConUtil *modelConUtil;
   ModelVarUtil *modelVarUtil;
   LocalMIP *localMIP;
+  vector<LocalMIP *> portfolioMIPs;
+  vector<LocalMIP *> componentMIPs;
   chrono::_V2::system_clock::time_point clkStart =
       chrono::high_resolution_clock::now();
   Solver();
@@ -0,0 +1,101 @@
+/*=====================================================================================
+
+    Filename:     Fenwick.h
+
+    Description:  Fenwick tree for weighted sampling without replacement
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#pragma once
+#include "header.h"
+
+// 线性时间建树；按权重抽样与删除均为 O(log n)
+class FenwickSampler
+{
+private:
+  vector<double> tree;   // tree[i] 为区间 (i - lowbit(i), i] 的权重和（下标从 1 开始）
+  vector<double> weight; // 各位置当前权重，已抽中的位置置 0
+  size_t size;
+  size_t topBit;
+
+public:
+  FenwickSampler()
+      : size(0),
+        topBit(0)
+  {
+  }
+
+  void Reserve(
+      size_t _capacity)
+  {
+    tree.reserve(_capacity + 1);
+    weight.reserve(_capacity);
+  }
+
+  // 按 _weightOf(pos) 为 [0, _size) 建树，权重必须为正
+  template <typename WeightOf>
+  void Build(
+      size_t _size,
+      WeightOf _weightOf)
+  {
+    size = _size;
+    weight.resize(size);
+    tree.assign(size + 1, 0);
+    for (size_t pos = 0; pos < size; ++pos)
+    {
+      weight[pos] = _weightOf(pos);
+      tree[pos + 1] += weight[pos];
+      size_t parent = (pos + 1) + ((pos + 1) & -(pos + 1));
+      if (parent <= size)
+        tree[parent] += tree[pos + 1];
+    }
+    topBit = 1;
+    while (topBit * 2 <= size)
+      topBit *= 2;
+  }
+
+  double Total() const
+  {
+    double total = 0;
+    for (size_t idx = size; idx > 0; idx -= idx & -idx)
+      total += tree[idx];
+    return total;
+  }
+
+  // 返回前缀和首次超过 _u * Total() 的位置，并将其权重置 0
+  size_t Draw(
+      double _u)
+  {
+    double target = _u * Total();
+    size_t idx = 0;
+    for (size_t bit = topBit; bit > 0; bit >>= 1)
+      if (idx + bit <= size && tree[idx + bit] <= target)
+      {
+        idx += bit;
+        target -= tree[idx];
+      }
+    size_t pos = idx < size ? idx : size - 1;
+    // 浮点误差可能落到已删除的位置上，顺延到相邻的正权重位置
+    for (size_t step = 0; weight[pos] <= 0 && step < size; ++step)
+      pos = pos + 1 < size ? pos + 1 : 0;
+    Remove(pos);
+    return pos;
+  }
+
+  void Remove(
+      size_t _pos)
+  {
+    double delta = -weight[_pos];
+    weight[_pos] = 0;
+    for (size_t idx = _pos + 1; idx <= size; idx += idx & -idx)
+      tree[idx] += delta;
+  }
+};
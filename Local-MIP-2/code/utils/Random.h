@@ -0,0 +1,102 @@
+/*=====================================================================================
+
+    Filename:     Random.h
+
+    Description:  xoshiro256++ generator with unbiased bounded draws
+        Version:  1.0
+
+    Author:       Peng Lin, penglincs@outlook.com
+
+    Organization: Shaowei Cai Group,
+                  State Key Laboratory of Computer Science,
+                  Institute of Software, Chinese Academy of Sciences,
+                  Beijing, China
+
+=====================================================================================*/
+
+#pragma once
+#include "header.h"
+
+// xoshiro256++：32 字节状态，每次生成只需移位、异或与加法
+class Random
+{
+private:
+  uint64_t state[4];
+
+  static uint64_t Rotl(
+      uint64_t _x,
+      int _k)
+  {
+    return (_x << _k) | (_x >> (64 - _k));
+  }
+
+public:
+  using result_type = uint64_t;
+
+  static constexpr uint64_t min()
+  {
+    return 0;
+  }
+
+  static constexpr uint64_t max()
+  {
+    return ~(uint64_t)0;
+  }
+
+  Random(
+      uint64_t _seed = 2832)
+  {
+    Seed(_seed);
+  }
+
+  // 用 splitmix64 把种子展开为四个状态字，避免全零状态
+  void Seed(
+      uint64_t _seed)
+  {
+    for (auto &word : state)
+    {
+      uint64_t z = (_seed += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      word = z ^ (z >> 31);
+    }
+  }
+
+  uint64_t operator()()
+  {
+    uint64_t result = Rotl(state[0] + state[3], 23) + state[0];
+    uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = Rotl(state[3], 45);
+    return result;
+  }
+
+  // [0, 1) 内的均匀浮点数，取高 53 位
+  double Uniform()
+  {
+    return ((*this)() >> 11) * 0x1.0p-53;
+  }
+
+  // Lemire 乘移位法：返回 [0, _bound) 内的无偏整数，绝大多数情况下无需除法
+  uint64_t Bounded(
+      uint64_t _bound)
+  {
+    assert(_bound > 0);
+    __uint128_t product = (__uint128_t)(*this)() * _bound;
+    uint64_t low = (uint64_t)product;
+    if (low < _bound)
+    {
+      uint64_t threshold = -_bound % _bound;
+      while (low < threshold)
+      {
+        product = (__uint128_t)(*this)() * _bound;
+        low = (uint64_t)product;
+      }
+    }
+    return product >> 64;
+  }
+};
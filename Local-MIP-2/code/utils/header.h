@@ -15,9 +15,12 @@
 =====================================================================================*/
 
 #pragma once
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <limits>
@@ -35,6 +38,15 @@ using namespace std;
 // 数值类型别名（默认为 double）
 using Value = double;
 
+// 模型项数组中的下标类型（变量/约束下标与行内/列内位置），默认 32 位；
+// 编译时定义 LMIP_INDEX64 改用 64 位。CSR/CSC 的起始偏移与步数计数仍为 size_t
+#ifdef LMIP_INDEX64
+using Index = uint64_t;
+#else
+using Index = uint32_t;
+#endif
+const size_t MaxIndex = numeric_limits<Index>::max();
+
 // 数值极限常量
 const Value Infinity = 1e20;                  // 正无穷
 const Value NegativeInfinity = -Infinity;     // 负无穷
@@ -61,6 +73,10 @@ std::chrono::_V2::system_clock::time_point TimeNow();  // 获取当前时间
 double ElapsedTime(const std::chrono::_V2::system_clock::time_point &a,
                    const std::chrono::_V2::system_clock::time_point &b);  // 计算时间差
 
+#ifdef LMIP_ALLOC_CHECK
+size_t AllocCount(); // 当前线程累计的 operator new 次数（仅 LMIP_ALLOC_CHECK 构建）
+#endif
+
 // 字符串工具函数
-bool IsBlank(const string &a);       // 检查字符串是否为空/空白
-void PrintfError(const string &a);   // 打印错误信息
+bool IsBlank(std::string_view a);       // 检查字符串是否为空/空白
+void PrintfError(std::string_view a);   // 打印错误信息
@@ -9,15 +9,40 @@
 // 数值参数宏定义
 // 格式: PARA(参数名, 类型, 短选项, 是否必填, 默认值, 最小值, 最大值, 描述)
 #define PARAS \
-    PARA( cutoff        , double, '\0' , false , 7200       , 0  , 1e8      , "Cutoff time") \
+    PARA( cutoff        , double, '\0' , false , 7200       , 0  , 1e8      , "Cutoff time in seconds (millisecond resolution)") \
+    PARA( workLimit     , double, '\0' , false , 0          , 0  , 1e18     , "Work-unit budget in coefficient touches (0: unlimited)") \
+    PARA( seed          , int   , '\0' , false , 2832       , 0  , 2147483647 , "Random seed")\
+    PARA( threads       , int   , '\0' , false , 1          , 1  , 256      , "Number of portfolio search threads")\
+    PARA( decompose     , int   , '\0' , false , 0          , 0  , 256      , "Maximum number of independent component sub-searches (0: no decomposition)")\
+    PARA( scoreThreads  , int   , '\0' , false , 1          , 1  , 256      , "Threads scoring one large neighbourhood in parallel")\
+    PARA( scoreParallelMin, int , '\0' , false , 512        , 1  , 2147483647 , "Minimum candidate number for parallel scoring")\
+    PARA( importStagnation, int , '\0' , false , 50000      , 0  , 2147483647 , "Steps without improvement before importing the shared best solution (0: never)")\
     PARA( PrintSol      , int   , '\0' , false , 1          , 0  , 1        , "Print best found solution or not")\
-    PARA( DEBUG         , int   , '\0' , false , 0          , 0  , 1        , "")
+    PARA( DEBUG         , int   , '\0' , false , 0          , 0  , 1        , "")\
+    PARA( incLHS        , int   , '\0' , false , 1          , 0  , 1        , "Incremental LHS update in ApplyMove or not")\
+    PARA( recomputeLHS  , int   , '\0' , false , 100000     , 0  , 1e9      , "Steps between full LHS recomputes (0: never)")\
+    PARA( intEngine     , int   , '\0' , false , 0          , 0  , 1        , "Exact integer engine for integral models: int64 tight deltas, no tolerance, no LHS recompute")\
+    PARA( simdScore     , int   , '\0' , false , 1          , 0  , 1        , "AVX2 TightScore kernel on long columns or not")\
+    PARA( scoreCache    , int   , '\0' , false , 0          , 0  , 1        , "Cache constraint scores per (variable, delta) or not")\
+    PARA( scheduler     , int   , '\0' , false , 0          , 0  , 3        , "Operator scheduler (0: fixed chain, 1: UCB1, 2: Thompson sampling, 3: EXP3)")\
+    PARA( bmsValue      , int   , '\0' , false , 0          , 0  , 1        , "BMS samples candidates in proportion to learned variable value or not")\
+    PARA( adaptBudget   , int   , '\0' , false , 0          , 0  , 1        , "Rescale BMS and sampling budgets online from measured throughput or not")\
+    PARA( budgetMinScale, double, '\0' , false , 0.1        , 0.01 , 1      , "Lower bound of the budget scale")\
+    PARA( budgetMaxScale, double, '\0' , false , 10         , 1  , 100      , "Upper bound of the budget scale")\
+    PARA( budgetEpoch   , int   , '\0' , false , 5000       , 100 , 1e9     , "Steps between budget adjustments")\
+    PARA( flipEngine    , int   , '\0' , false , 0          , 0  , 1        , "Incremental flip scores and best-flip heap on pure binary models or not")\
+    PARA( propagate     , int   , '\0' , false , 0          , 0  , 1        , "Activity-based bound propagation in presolve or not")\
+    PARA( propagateWork , double, '\0' , false , 1e8        , 0  , 1e18     , "Work budget of bound propagation in coefficient touches")\
+    PARA( reduce        , int   , '\0' , false , 0          , 0  , 1        , "Presolve reductions of redundant and parallel rows, dominated and free singleton columns or not")\
+    PARA( snapshotNames , int   , '\0' , false , 1          , 0  , 1        , "Store constraint and variable names in the model snapshot or not")
 
 // 字符串参数宏定义
 // 格式: STR_PARA(参数名, 短选项, 是否必填, 默认值, 描述)
 #define STR_PARAS \
-    STR_PARA( instance   , 'i'   ,  true    , "" , ".mps format instance")\
-    STR_PARA( log       , 'l'  ,  false  , "./result.csv", "log file")
+    STR_PARA( instance   , 'i'   ,  false   , "" , ".mps format instance")\
+    STR_PARA( log       , 'l'  ,  false  , "./result.csv", "log file")\
+    STR_PARA( saveModel , '\0' ,  false  , "" , "write the read model to a binary snapshot")\
+    STR_PARA( loadModel , '\0' ,  false  , "" , "read the model from a binary snapshot instead of an instance")
 
 struct paras {
     // 展开 PARAS 宏，生成数值类型成员变量
@@ -17,6 +17,81 @@ Filename:     utils.cpp
 
 #include "header.h"  // 包含自定义头文件（可能定义了相关类型）
 
+#ifdef LMIP_ALLOC_CHECK
+#include <new>
+
+// 开启 LMIP_ALLOC_CHECK 时统计堆分配次数，用于断言主循环无分配；
+// 替换普通、nothrow 与按对齐分配的全部形式，数组形式默认转发到这些函数
+static thread_local size_t allocNum = 0;
+
+void *operator new(size_t _size)
+{
+  ++allocNum;
+  if (void *ptr = malloc(_size ? _size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new(size_t _size, const std::nothrow_t &) noexcept
+{
+  ++allocNum;
+  return malloc(_size ? _size : 1);
+}
+
+void *operator new(size_t _size, std::align_val_t _align)
+{
+  ++allocNum;
+  size_t align = max((size_t)_align, sizeof(void *));
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, align, _size ? _size : 1) == 0)
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new(size_t _size, std::align_val_t _align, const std::nothrow_t &) noexcept
+{
+  ++allocNum;
+  size_t align = max((size_t)_align, sizeof(void *));
+  void *ptr = nullptr;
+  return posix_memalign(&ptr, align, _size ? _size : 1) == 0 ? ptr : nullptr;
+}
+
+void operator delete(void *_ptr) noexcept
+{
+  free(_ptr);
+}
+
+void operator delete(void *_ptr, size_t) noexcept
+{
+  free(_ptr);
+}
+
+void operator delete(void *_ptr, const std::nothrow_t &) noexcept
+{
+  free(_ptr);
+}
+
+void operator delete(void *_ptr, std::align_val_t) noexcept
+{
+  free(_ptr);
+}
+
+void operator delete(void *_ptr, size_t, std::align_val_t) noexcept
+{
+  free(_ptr);
+}
+
+void operator delete(void *_ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+  free(_ptr);
+}
+
+size_t AllocCount()
+{
+  return allocNum;
+}
+#endif
+
 // 获取当前高精度时间点
 std::chrono::_V2::system_clock::time_point TimeNow() {
   return chrono::high_resolution_clock::now();  // 返回纳秒级时间戳
@@ -31,7 +106,7 @@ double ElapsedTime(
 }
 
 // 检查字符串是否仅包含空白字符（空格/换行符）
-bool IsBlank(const string &a) {
+bool IsBlank(std::string_view a) {
   for (auto x : a)
     if (x != ' ' && x != '\n' && x != '\r')  // 发现非空白字符立即返回false
       return false;
@@ -39,7 +114,7 @@ bool IsBlank(const string &a) {
 }
 
 // 打印错误信息并终止程序
-void PrintfError(const string &a) {
-  printf("c error line: %s\n", a.c_str());  // 'c'前缀可能表示调试信息
+void PrintfError(std::string_view a) {
+  printf("c error line: %.*s\n", (int)a.size(), a.data());  // 'c'前缀可能表示调试信息
   exit(-1);  // 非正常退出（错误码-1）#include "header.h"  // 包含自定义头文件（可能定义了相关类型）
 }
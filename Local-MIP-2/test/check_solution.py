@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+# =====================================================================================
+#
+#     Filename:     check_solution.py
+#
+#     Description:  Regression check: run Local-MIP on an instance and verify the
+#                   reported (postsolved) solution against the original MPS model
+#
+# =====================================================================================
+#
+# 用法: check_solution.py <Local-MIP> <instance.mps> <expected output regex> [solver options...]
+# 检查项：输出中出现期望的预处理统计；解满足原模型的全部约束、界与整数性；报告的目标值与解一致
+
+import re
+import subprocess
+import sys
+
+FeasibilityTol = 1e-5
+Infinity = float("inf")
+
+
+def parse_mps(path):
+    rows = {}  # 行名 -> 类型
+    objName = None
+    coeffs = {}  # 行名 -> {变量: 系数}
+    objCoeffs = {}
+    rhs = {}
+    ranges = {}
+    bounds = {}  # 变量 -> [下界, 上界]
+    integers = set()
+    isMax = False
+    section = None
+    isIntegerMarker = False
+    for line in open(path):
+        tokens = line.split()
+        if not tokens or line[0] == "*":
+            continue
+        if not line[0].isspace():
+            section = tokens[0]
+            if section == "OBJSENSE" and len(tokens) > 1:
+                isMax = tokens[1] == "MAX"
+            continue
+        if section == "OBJSENSE":
+            isMax = tokens[0] == "MAX"
+        elif section == "ROWS":
+            if tokens[0] == "N":
+                if objName is None:
+                    objName = tokens[1]
+            else:
+                rows[tokens[1]] = tokens[0]
+        elif section == "COLUMNS":
+            if "'MARKER'" in tokens:
+                isIntegerMarker = "'INTORG'" in tokens
+                continue
+            var = tokens[0]
+            if var not in bounds:
+                bounds[var] = [0.0, Infinity]
+                if isIntegerMarker:
+                    integers.add(var)
+                    bounds[var][1] = 1.0  # 整数标记段内的变量默认为二进制
+            for k in range(1, len(tokens) - 1, 2):
+                row, value = tokens[k], float(tokens[k + 1])
+                if row == objName:
+                    objCoeffs[var] = value
+                elif row in rows:
+                    coeffs.setdefault(row, {})[var] = value
+        elif section in ("RHS", "RANGES"):
+            pairs = tokens[1:] if len(tokens) % 2 == 1 else tokens
+            target = rhs if section == "RHS" else ranges
+            for k in range(0, len(pairs) - 1, 2):
+                target[pairs[k]] = float(pairs[k + 1])
+        elif section == "BOUNDS":
+            kind, rest = tokens[0], tokens[1:]
+            # 集合名可省略：带值的类型有 3 个记号时含集合名；BV 的值可省略，两个记号时按首个记号是否为列名判断
+            if kind in ("FR", "MI", "PL"):
+                hasSetName = len(rest) >= 2
+            elif kind == "BV":
+                hasSetName = len(rest) >= 3 or (len(rest) == 2 and rest[0] not in bounds)
+            else:
+                hasSetName = len(rest) >= 3
+            if hasSetName:
+                rest = rest[1:]
+            var = rest[0]
+            value = float(rest[1]) if len(rest) > 1 else 0.0
+            bound = bounds.setdefault(var, [0.0, Infinity])
+            if var in integers and bound == [0.0, 1.0]:
+                bound[1] = Infinity  # 整数变量给出任何界后不再默认为二进制
+            if kind == "UP":
+                bound[1] = value
+                if value < 0 and bound[0] == 0:
+                    bound[0] = -Infinity
+            elif kind in ("LO", "LI"):
+                bound[0] = value
+            elif kind == "UI":
+                bound[1] = value
+            elif kind == "FX":
+                bound[0] = bound[1] = value
+            elif kind == "FR":
+                bound[0], bound[1] = -Infinity, Infinity
+            elif kind == "MI":
+                bound[0] = -Infinity
+            elif kind == "PL":
+                bound[1] = Infinity
+            elif kind == "BV":
+                bound[0], bound[1] = 0.0, 1.0
+            if kind in ("BV", "LI", "UI"):
+                integers.add(var)
+    return rows, coeffs, objCoeffs, rhs, ranges, bounds, integers, isMax
+
+
+def row_sides(kind, b, r):
+    if kind == "L":
+        return (b - abs(r), b) if r is not None else (-Infinity, b)
+    if kind == "G":
+        return (b, b + abs(r)) if r is not None else (b, Infinity)
+    if r is None:
+        return (b, b)
+    return (b, b + r) if r > 0 else (b + r, b)
+
+
+def main():
+    solver, instance, expected = sys.argv[1:4]
+    options = sys.argv[4:]
+    output = subprocess.run(
+        [solver, "--instance=" + instance, "--PrintSol=1"] + options,
+        capture_output=True, text=True).stdout
+    failures = []
+    if not re.search(expected, output):
+        failures.append("expected output /%s/ not found" % expected)
+
+    reported = re.search(r"^o Best objective: (\S+)", output, re.M)
+    values = {}
+    isSolution = False
+    for line in output.splitlines():
+        if line.startswith("Variable name"):
+            isSolution = True
+        elif isSolution and line and not line.startswith("c"):
+            tokens = line.split()
+            values[tokens[0]] = float(tokens[1])
+    if reported is None:
+        failures.append("no feasible solution reported")
+    else:
+        rows, coeffs, objCoeffs, rhs, ranges, bounds, integers, isMax = parse_mps(instance)
+        for row, kind in rows.items():
+            activity = sum(c * values.get(v, 0.0) for v, c in coeffs.get(row, {}).items())
+            lower, upper = row_sides(kind, rhs.get(row, 0.0), ranges.get(row))
+            scale = FeasibilityTol * max(1.0, abs(activity))
+            if activity < lower - scale or activity > upper + scale:
+                failures.append("row %s: activity %g outside [%g, %g]" % (row, activity, lower, upper))
+        for var, (lower, upper) in bounds.items():
+            value = values.get(var, 0.0)
+            if value < lower - FeasibilityTol or value > upper + FeasibilityTol:
+                failures.append("column %s: value %g outside [%g, %g]" % (var, value, lower, upper))
+            if var in integers and abs(value - round(value)) > FeasibilityTol:
+                failures.append("column %s: value %g is not integral" % (var, value))
+        objective = sum(c * values.get(v, 0.0) for v, c in objCoeffs.items())
+        if abs(objective - float(reported.group(1))) > FeasibilityTol * max(1.0, abs(objective)):
+            failures.append("objective %g of the solution differs from reported %s" %
+                            (objective, reported.group(1)))
+
+    for failure in failures:
+        print(failure)
+    print("%s: %s" % (instance, "FAILED" if failures else "OK"))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
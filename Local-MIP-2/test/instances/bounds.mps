@@ -0,0 +1,18 @@
+* Free-format BOUNDS with and without a bound set name: "BV x 1" has no set
+* name and an explicit value, "UP BND y 3" and "BV BND z" have one. Read
+* correctly, x and z are binary and y <= 3, so the optimum is -5
+NAME BOUNDS
+ROWS
+ N obj
+ L c1
+COLUMNS
+    x    obj    -1    c1    1
+    y    obj    -1    c1    1
+    z    obj    -1    c1    1
+RHS
+    RHS    c1    10
+BOUNDS
+ BV x 1
+ UP BND y 3
+ BV BND z
+ENDATA
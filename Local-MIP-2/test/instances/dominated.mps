@@ -0,0 +1,24 @@
+* Dominated columns: lowering z never hurts a row and z costs 1, so z is fixed at 0;
+* raising w never hurts a row and w has negative cost, so w is fixed at its upper bound
+NAME DOMINATED
+ROWS
+ N obj
+ G c1
+ L c2
+COLUMNS
+    MARKER    'MARKER'    'INTORG'
+    x    obj    3    c1    1
+    x    c2    1
+    y    obj    2    c1    1
+    y    c2    1
+    z    obj    1    c2    1
+    w    obj    -1    c1    1
+    MARKER    'MARKER'    'INTEND'
+RHS
+    RHS    c1    4    c2    10
+BOUNDS
+ UP BND x 8
+ UP BND y 8
+ UP BND z 5
+ UP BND w 2
+ENDATA
@@ -0,0 +1,25 @@
+* Parallel rows: c2 is c1 scaled by 2 with a tighter side, c3 is c1 scaled by -1;
+* the merged row must keep the tightest side, x + 2y <= 6
+NAME PARALLEL
+ROWS
+ N obj
+ L c1
+ L c2
+ G c3
+ G c4
+COLUMNS
+    MARKER    'MARKER'    'INTORG'
+    x    obj    -1    c1    1
+    x    c2    2    c3    -1
+    x    c4    1
+    y    obj    -3    c1    2
+    y    c2    4    c3    -2
+    y    c4    1
+    MARKER    'MARKER'    'INTEND'
+RHS
+    RHS    c1    8    c2    12
+    RHS    c3    -7    c4    1
+BOUNDS
+ UP BND x 10
+ UP BND y 10
+ENDATA
@@ -0,0 +1,25 @@
+* Bound propagation: x, y and z are integer without upper bounds;
+* c1 implies x <= 5, y <= 10 and z <= 10
+NAME PROPAGATE
+ROWS
+ N obj
+ L c1
+ G c2
+ L c3
+COLUMNS
+    MARKER    'MARKER'    'INTORG'
+    x    obj    -3    c1    2
+    x    c2    1
+    y    obj    -2    c1    1
+    y    c3    1
+    z    obj    -1    c1    1
+    z    c3    -1
+    MARKER    'MARKER'    'INTEND'
+RHS
+    RHS    c1    10    c2    1
+    RHS    c3    2
+BOUNDS
+ PL BND x
+ PL BND y
+ PL BND z
+ENDATA
@@ -0,0 +1,24 @@
+* Redundant row: c2 cannot be violated within the column bounds
+NAME REDUNDANT
+ROWS
+ N obj
+ L c1
+ L c2
+ G c3
+COLUMNS
+    MARKER    'MARKER'    'INTORG'
+    x    obj    -1    c1    1
+    x    c2    1    c3    1
+    y    obj    -1    c1    2
+    y    c2    1    c3    1
+    z    obj    -1    c1    1
+    z    c2    1
+    MARKER    'MARKER'    'INTEND'
+RHS
+    RHS    c1    6    c2    100
+    RHS    c3    2
+BOUNDS
+ UP BND x 5
+ UP BND y 5
+ UP BND z 5
+ENDATA
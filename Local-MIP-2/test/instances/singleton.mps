@@ -0,0 +1,27 @@
+* Free singleton columns: s appears only in the equality row f and carries cost,
+* so f is substituted into the objective; t appears only in g with no cost, so g
+* is dropped. Postsolve must restore s and t so that f and g hold
+NAME SINGLETON
+ROWS
+ N obj
+ G c1
+ E f
+ L g
+COLUMNS
+    MARKER    'MARKER'    'INTORG'
+    x    obj    1    c1    1
+    x    f    1    g    1
+    y    obj    1    c1    1
+    y    f    1
+    MARKER    'MARKER'    'INTEND'
+    s    obj    2    f    -1
+    t    g    -1
+RHS
+    RHS    c1    2    f    3
+    RHS    g    5
+BOUNDS
+ UP BND x 10
+ UP BND y 10
+ FR BND s
+ FR BND t
+ENDATA